@@ -1,39 +1,151 @@
 #pragma once
-#include "ChessLogic.hpp"
+#include "MovePicker.hpp"
+#include "PawnEvaluation.hpp"
 #include "Piece.hpp"
+#include "Position.hpp"
+#include "TimeManager.hpp"
+#include "TranspositionTable.hpp"
+#include <array>
 #include <utility>
+#include <vector>
 
 namespace Jr {
 
 struct AIMove {
     int from = -1;
     int to = -1;
+    PieceType promotion = PieceType::None; ///< Pièce choisie si le coup est une promotion
     int score = 0;
 };
 
+/// Résultat d'une itération complète de l'approfondissement itératif
+struct SearchIteration {
+    int depth = 0;
+    Move move = Move::none(); ///< Meilleur coup à cette profondeur
+    int score = 0;
+    uint64_t nodes = 0;       ///< Nœuds visités depuis le début de la recherche
+    double seconds = 0.0;     ///< Temps écoulé depuis le début de la recherche
+};
+
 /**
  * @class AIPlayer
  * @brief Moteur d'IA pour jouer aux échecs avec algorithme Minimax et élagage alpha-bêta
  */
 class AIPlayer {
 public:
-    explicit AIPlayer(int depth = 3);
+    /**
+     * @param depth Profondeur de recherche en demi-coups.
+     * @param hashMegabytes Taille de la table de transposition en Mo.
+     */
+    explicit AIPlayer(int depth = 3, size_t hashMegabytes = 16);
 
-    // Trouve le meilleur coup pour la position donnée
-    AIMove findBestMove(const ChessLogic& logic);
+    // Trouve le meilleur coup pour la position donnée (une copie de taille fixe).
+    // `history` contient les hashs de la partie depuis le dernier coup irréversible (voir
+    // ChessLogic::getRepetitionHistory) pour reconnaître les répétitions avec les coups déjà joués.
+    // Approfondissement itératif jusqu'à la profondeur maximale ; avec une pendule dans `limits`,
+    // le TimeManager arrête la recherche plus tôt et le coup de la dernière itération complète est joué.
+    AIMove findBestMove(const Position& position, const std::vector<uint64_t>& history = {},
+                        const SearchLimits& limits = {});
 
     void setDepth(int d) { maxDepth = d; }
     int getDepth() const { return maxDepth; }
 
+    /// Nombre de nœuds visités lors du dernier appel à findBestMove
+    uint64_t getNodeCount() const { return nodeCount; }
+
+    /// Profondeur de la dernière itération complète lors du dernier appel à findBestMove
+    int getCompletedDepth() const { return completedDepth; }
+
+    /// Itérations complètes du dernier appel à findBestMove, de la profondeur 1 à la plus profonde
+    const std::vector<SearchIteration>& getIterations() const { return iterations; }
+
+    /// Proportion des coupures bêta obtenues dès le premier coup essayé (qualité de l'ordre des coups)
+    double getFirstMoveCutoffRate() const {
+        return cutoffCount > 0 ? static_cast<double>(firstMoveCutoffCount) / cutoffCount : 0.0;
+    }
+
+    /// Table de hachage des pions (compteurs d'accès remis à zéro à chaque findBestMove)
+    const PawnHashTable& getPawnTable() const { return pawnTable; }
+
+    /// Oublie les positions mémorisées (nouvelle partie)
+    void clearTranspositionTable() { transpositionTable.clear(); }
+
 private:
+    /// Score d'un mat au ply 0 ; un mat à `ply` demi-coups vaut MATE_SCORE - ply (les mats rapides sont préférés)
+    static constexpr int MATE_SCORE = 1000000;
+
+    /// Profondeur maximale de la pile d'annulation (en demi-coups)
+    static constexpr int MAX_PLY = 64;
+
+    /// Un score de mat mémorisé est compté depuis le nœud, et non depuis la racine (voir scoreToTT)
+    static int scoreToTT(int score, int ply);
+    static int scoreFromTT(int score, int ply);
+
     int maxDepth;
 
-    AIMove minimax(ChessLogic node, int depth, int alpha, int beta, bool maximizingPlayer);
-    int evaluate(const ChessLogic& logic) const;
-    int pieceValue(PieceType t) const;
-    
-    // Simule un coup et gère automatiquement la promotion
-    static void simulateMoveAndResolve(ChessLogic& logicCopy, int from, int to);
+    /// Nœuds visités par la recherche en cours
+    uint64_t nodeCount = 0;
+
+    /// Coupures bêta de la recherche en cours, et celles provoquées par le premier coup essayé
+    uint64_t cutoffCount = 0;
+    uint64_t firstMoveCutoffCount = 0;
+
+    /// Coups killer de chaque ply (remis à zéro à chaque findBestMove)
+    std::array<KillerMoves, MAX_PLY> killers{};
+
+    /// Historique des coups tranquilles, vieilli à chaque findBestMove
+    HistoryTable historyTable;
+
+    /// Pendule de la recherche en cours
+    TimeManager timeManager;
+
+    /// Levé quand la limite dure est atteinte : l'itération en cours est abandonnée
+    bool searchStopped = false;
+
+    /// La pendule n'est consultée qu'une fois tous les (TIME_CHECK_INTERVAL) nœuds
+    static constexpr uint64_t TIME_CHECK_INTERVAL = 2048;
+
+    int completedDepth = 0;
+    std::vector<SearchIteration> iterations;
+
+    /// Positions déjà cherchées, conservées d'un coup à l'autre (vieillies à chaque findBestMove)
+    TranspositionTable transpositionTable;
+
+    /// Évaluations de structure de pions déjà calculées (une table par AIPlayer, donc par thread de recherche)
+    PawnHashTable pawnTable;
+
+    /// Informations d'annulation de chaque demi-coup de la recherche, indexées par ply
+    std::array<UndoInfo, MAX_PLY> undoStack{};
+
+    /// Hashs de la partie puis de la branche en cours, pour détecter les répétitions dans l'arbre
+    std::vector<uint64_t> hashStack;
+
+    // La recherche joue et annule les coups sur une unique position (pas de copie par nœud)
+    AIMove minimax(Position& node, int depth, int ply, int alpha, int beta, bool maximizingPlayer);
+
+    /// Marge de l'élagage delta : une capture qui ne peut pas ramener le score au niveau d'alpha est ignorée
+    static constexpr int DELTA_MARGIN = 200;
+
+    /**
+     * @brief Recherche de quiescence : aux feuilles, seules les captures et les promotions en dame sont
+     * jouées jusqu'à une position calme, pour ne pas évaluer au milieu d'un échange.
+     * Le camp au trait peut s'arrêter sur l'évaluation statique ("stand pat"), sauf s'il est en échec
+     * au premier ply de quiescence : toutes les parades sont alors cherchées, et un mat est reconnu.
+     */
+    int quiescence(Position& node, int ply, int qPly, int alpha, int beta, bool maximizingPlayer);
+
+    /// Consulte la pendule tous les TIME_CHECK_INTERVAL nœuds ; vrai si la recherche doit être abandonnée
+    bool checkTime();
+    int evaluate(const Position& position);
+
+    /// Les cases attaquées par les pions adverses ne comptent pas dans la mobilité (une pièce n'y va pas sans risque)
+    static constexpr bool MOBILITY_EXCLUDES_PAWN_ATTACKS = true;
+
+    /**
+     * @brief Mobilité d'un camp : cases atteintes par ses cavaliers, fous, tours et dames (attaques pseudo-légales),
+     * hors cases occupées par ses propres pièces. Un popcount par pièce, sans génération de coups.
+     */
+    int mobility(const Position& position, PieceColor color) const;
 };
 
 } // namespace Jr
@@ -0,0 +1,200 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace Jr {
+
+    /**
+     * @file Bitboard.hpp
+     * @brief Utilitaires de bitboards et tables d'attaques précalculées à la compilation.
+     *
+     * Convention des cases : a1 = 0, h1 = 7, a8 = 56, h8 = 63 (index = rangée * 8 + colonne).
+     */
+
+    /// Masques de colonnes et de rangées utiles à la génération de coups
+    inline constexpr uint64_t FILE_A = 0x0101010101010101ULL;
+    inline constexpr uint64_t FILE_H = 0x8080808080808080ULL;
+    inline constexpr uint64_t RANK_1 = 0x00000000000000FFULL;
+    inline constexpr uint64_t RANK_3 = 0x0000000000FF0000ULL;
+    inline constexpr uint64_t RANK_6 = 0x0000FF0000000000ULL;
+    inline constexpr uint64_t RANK_8 = 0xFF00000000000000ULL;
+
+    /// Bitboard contenant uniquement la case donnée
+    constexpr uint64_t squareBit(int sq) { return 1ULL << sq; }
+
+    /// Nombre de cases occupées dans un bitboard
+    constexpr int popCount(uint64_t bb) { return std::popcount(bb); }
+
+    /// Index de la case la plus basse d'un bitboard non vide
+    constexpr int lsb(uint64_t bb) { return std::countr_zero(bb); }
+
+    /**
+     * @brief Retire la case la plus basse d'un bitboard non vide et retourne son index.
+     * @param bb Bitboard modifié sur place.
+     * @return Index de la case retirée.
+     */
+    constexpr int popLsb(uint64_t& bb) {
+        int sq = std::countr_zero(bb);
+        bb &= bb - 1;
+        return sq;
+    }
+
+    /// Décalage d'un bitboard d'une rangée vers le haut (côté des noirs)
+    constexpr uint64_t shiftNorth(uint64_t bb) { return bb << 8; }
+
+    /// Décalage d'un bitboard d'une rangée vers le bas (côté des blancs)
+    constexpr uint64_t shiftSouth(uint64_t bb) { return bb >> 8; }
+
+    /// Cases attaquées par un ensemble de pions (tous à la fois, par décalages)
+    constexpr uint64_t pawnAttacksSet(uint64_t pawns, bool white) {
+        return white ? ((pawns & ~FILE_A) << 7) | ((pawns & ~FILE_H) << 9)
+                     : ((pawns & ~FILE_A) >> 9) | ((pawns & ~FILE_H) >> 7);
+    }
+
+    namespace detail {
+
+        /**
+         * @brief Construit la table d'attaques d'une pièce "sauteuse" (cavalier, roi, capture de pion).
+         * @param deltas Liste des décalages (rangée, colonne) possibles.
+         * @return Table de 64 bitboards, un par case de départ.
+         */
+        template <std::size_t N>
+        constexpr std::array<uint64_t, 64> makeLeaperAttacks(const int (&deltas)[N][2]) {
+            std::array<uint64_t, 64> table{};
+            for (int sq = 0; sq < 64; ++sq) {
+                int row = sq / 8;
+                int col = sq % 8;
+                for (const auto& d : deltas) {
+                    int r = row + d[0];
+                    int c = col + d[1];
+                    if (r >= 0 && r < 8 && c >= 0 && c < 8) {
+                        table[sq] |= squareBit(r * 8 + c);
+                    }
+                }
+            }
+            return table;
+        }
+
+        inline constexpr int KNIGHT_DELTAS[8][2] = {{2,1},{2,-1},{-2,1},{-2,-1},{1,2},{1,-2},{-1,2},{-1,-2}};
+        inline constexpr int KING_DELTAS[8][2] = {{1,-1},{1,0},{1,1},{0,-1},{0,1},{-1,-1},{-1,0},{-1,1}};
+        inline constexpr int WHITE_PAWN_CAPTURES[2][2] = {{1,-1},{1,1}};
+        inline constexpr int BLACK_PAWN_CAPTURES[2][2] = {{-1,-1},{-1,1}};
+    }
+
+    /// Cases attaquées par un cavalier depuis chaque case
+    inline constexpr std::array<uint64_t, 64> KNIGHT_ATTACKS = detail::makeLeaperAttacks(detail::KNIGHT_DELTAS);
+
+    /// Cases attaquées par un roi depuis chaque case
+    inline constexpr std::array<uint64_t, 64> KING_ATTACKS = detail::makeLeaperAttacks(detail::KING_DELTAS);
+
+    /// Cases attaquées (prises) par un pion, indexées par [couleur][case] (0 = blancs, 1 = noirs)
+    inline constexpr std::array<std::array<uint64_t, 64>, 2> PAWN_ATTACKS = {
+        detail::makeLeaperAttacks(detail::WHITE_PAWN_CAPTURES),
+        detail::makeLeaperAttacks(detail::BLACK_PAWN_CAPTURES)
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Construit une table indexée par paires de cases alignées (même rangée, colonne ou diagonale).
+         * @param fullLine true : la ligne complète passant par les deux cases, d'un bord à l'autre ;
+         *                 false : uniquement les cases situées strictement entre les deux.
+         * @return Table [a][b], vide pour deux cases non alignées (ou identiques).
+         */
+        constexpr std::array<std::array<uint64_t, 64>, 64> makeSquarePairTable(bool fullLine) {
+            std::array<std::array<uint64_t, 64>, 64> table{};
+            for (int a = 0; a < 64; ++a) {
+                for (int b = 0; b < 64; ++b) {
+                    int dr = b / 8 - a / 8;
+                    int dc = b % 8 - a % 8;
+                    if (a == b || !(dr == 0 || dc == 0 || dr == dc || dr == -dc)) continue;
+                    int stepR = (dr > 0) - (dr < 0);
+                    int stepC = (dc > 0) - (dc < 0);
+                    uint64_t bb = 0ULL;
+                    if (fullLine) {
+                        // Part de `a` dans les deux sens jusqu'aux bords.
+                        bb |= squareBit(a);
+                        for (int dir : {1, -1}) {
+                            int r = a / 8 + dir * stepR, c = a % 8 + dir * stepC;
+                            while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+                                bb |= squareBit(r * 8 + c);
+                                r += dir * stepR; c += dir * stepC;
+                            }
+                        }
+                    } else {
+                        for (int r = a / 8 + stepR, c = a % 8 + stepC; r * 8 + c != b; r += stepR, c += stepC) {
+                            bb |= squareBit(r * 8 + c);
+                        }
+                    }
+                    table[a][b] = bb;
+                }
+            }
+            return table;
+        }
+    }
+
+    /// Cases strictement comprises entre deux cases alignées, indexées par [a][b] (0 si non alignées)
+    inline constexpr std::array<std::array<uint64_t, 64>, 64> BETWEEN = detail::makeSquarePairTable(false);
+
+    /// Ligne complète (bord à bord) passant par deux cases alignées, indexée par [a][b] (0 si non alignées)
+    inline constexpr std::array<std::array<uint64_t, 64>, 64> LINE = detail::makeSquarePairTable(true);
+
+    /**
+     * @struct Magic
+     * @brief Paramètres "magic bitboard" d'une case pour une pièce glissante (tour ou fou).
+     *
+     * Les cases pertinentes de l'occupation (masque) sont multipliées par le nombre magique,
+     * et les bits de poids fort du produit donnent directement l'index dans la table d'attaques.
+     */
+    struct Magic {
+        uint64_t mask = 0ULL;             ///< Cases pouvant bloquer la pièce (bords exclus)
+        uint64_t magic = 0ULL;            ///< Nombre magique sans collision destructive
+        const uint64_t* attacks = nullptr; ///< Début de la sous-table d'attaques de cette case
+        unsigned shift = 0;               ///< 64 - nombre de bits du masque
+
+        /// Index dans la sous-table pour une occupation donnée
+        uint64_t index(uint64_t occupancy) const {
+            return ((occupancy & mask) * magic) >> shift;
+        }
+    };
+
+    namespace detail {
+        extern std::array<Magic, 64> rookMagics;
+        extern std::array<Magic, 64> bishopMagics;
+    }
+
+    /**
+     * @brief Initialise les tables magic des pièces glissantes.
+     *
+     * Le calcul n'est effectué qu'une seule fois par processus, quel que soit le nombre d'appels
+     * (std::call_once) : il doit avoir eu lieu avant tout appel à rookAttacks/bishopAttacks.
+     */
+    void initBitboards();
+
+    /// Cases attaquées par une tour sur `sq` pour une occupation donnée : une multiplication, un décalage, une lecture
+    inline uint64_t rookAttacks(int sq, uint64_t occupancy) {
+        const Magic& m = detail::rookMagics[sq];
+        return m.attacks[m.index(occupancy)];
+    }
+
+    /// Cases attaquées par un fou sur `sq` pour une occupation donnée
+    inline uint64_t bishopAttacks(int sq, uint64_t occupancy) {
+        const Magic& m = detail::bishopMagics[sq];
+        return m.attacks[m.index(occupancy)];
+    }
+
+    /// Cases attaquées par une dame : union des attaques de tour et de fou
+    inline uint64_t queenAttacks(int sq, uint64_t occupancy) {
+        return rookAttacks(sq, occupancy) | bishopAttacks(sq, occupancy);
+    }
+
+    static_assert(KNIGHT_ATTACKS[0] == 0x0000000000020400ULL, "Table des cavaliers incorrecte");
+    static_assert(KING_ATTACKS[0] == 0x0000000000000302ULL, "Table des rois incorrecte");
+    static_assert(PAWN_ATTACKS[0][8] == 0x0000000000020000ULL, "Table des pions incorrecte");
+    static_assert(pawnAttacksSet(squareBit(12), true) == (squareBit(19) | squareBit(21)) &&
+                  pawnAttacksSet(squareBit(48), false) == squareBit(41), "Attaques de pions par ensemble incorrectes");
+    static_assert(BETWEEN[0][63] == 0x0040201008040200ULL && BETWEEN[0][7] == 0x7EULL && BETWEEN[0][17] == 0ULL,
+                  "Table BETWEEN incorrecte");
+    static_assert(LINE[9][18] == 0x8040201008040201ULL && LINE[8][10] == 0xFF00ULL, "Table LINE incorrecte");
+}
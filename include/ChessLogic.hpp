@@ -5,6 +5,7 @@
 #include <vector>
 #include <cstdint> // Pour uint64_t
 #include "Piece.hpp" // Inclure la nouvelle structure Piece
+#include "Position.hpp"
 
 namespace Jr {
 
@@ -12,8 +13,9 @@ namespace Jr {
      * @class ChessLogic
      * @brief Gestion complète de la logique d'un jeu d'échecs.
      * 
-     * Cette classe maintient l'état interne du plateau sous forme de bitboards,
-     * gère le tour des joueurs, les règles spéciales (roque, prise en passant, promotion)
+     * Cette classe enveloppe une Position (l'état du plateau sous forme de bitboards)
+     * avec ce dont l'interface a besoin : historique (coups compacts et points de contrôle), captures, promotion en attente.
+     * Elle gère le tour des joueurs, les règles spéciales (roque, prise en passant, promotion)
      * et valide les coups selon les règles officielles.
      * 
      * Elle fournit des méthodes pour interagir avec la logique du jeu, comme vérifier la validité
@@ -29,53 +31,11 @@ namespace Jr {
         DrawMaterial
     };
 
-    // Structure pour sauvegarder un état complet du jeu
-    struct Snapshot {
-        std::map<std::string, uint64_t> bitboards;
-        uint64_t bitboardPieces;
-        bool whiteTurn;
-        int enPassantSquare;
-        bool whiteKingMoved;
-        bool whiteRookKingsideMoved;
-        bool whiteRookQueensideMoved;
-        bool blackKingMoved;
-        bool blackRookKingsideMoved;
-        bool blackRookQueensideMoved;
-        int fiftyMoveCounter;
-        uint64_t currentZobristHash;
-    };
-
     class ChessLogic {
     private:
-        /// Bitboards représentant la position de chaque type de pièce, identifiées par une chaîne (ex: "wP" pour pions blancs)
-        std::map<std::string, uint64_t> bitboards;
-
-        /// Bitboard représentant toutes les cases occupées par une pièce (blanche ou noire)
-        uint64_t bitboardPieces;
-
-        /// Indique si c'est au tour des blancs de jouer (true) ou des noirs (false)
-        bool whiteTurn = true;
-
-        /// Index de la case cible d'une prise en passant possible, ou -1 si aucune
-        int enPassantSquare = -1;
-
-        /// Indique si le roi blanc a déjà bougé (affecte la possibilité de roque)
-        bool whiteKingMoved = false;
-
-        /// Indique si la tour blanche côté roi a déjà bougé
-        bool whiteRookKingsideMoved = false;
-
-        /// Indique si la tour blanche côté dame a déjà bougé
-        bool whiteRookQueensideMoved = false;
-
-        /// Indique si le roi noir a déjà bougé
-        bool blackKingMoved = false;
-
-        /// Indique si la tour noire côté roi a déjà bougé
-        bool blackRookKingsideMoved = false;
-
-        /// Indique si la tour noire côté dame a déjà bougé
-        bool blackRookQueensideMoved = false;
+        /// État de la partie vu par les règles (pièces, trait, roque, prise en passant, hash).
+        /// Tout le reste de la classe (historique, captures, promotion en attente) ne sert qu'à l'interface.
+        Position position;
 
         /// Indique si une promotion de pion est en attente
         bool promotionPending = false;
@@ -86,55 +46,57 @@ namespace Jr {
         /// Case où la promotion doit avoir lieu (index), -1 si aucune promotion en attente
         int promotionSquare = -1;
 
-        /**
-         * @brief Vérifie si la case spécifiée est vide.
-         * @param sq Index de la case (0-63)
-         * @return true si la case est vide, false sinon.
-         */
-        bool isEmpty(int sq) const;
+        /// Case de départ du pion en attente de promotion : le coup n'est appliqué qu'une fois la pièce choisie
+        int promotionFrom = -1;
 
         /**
-         * @brief Vérifie si la pièce à la case donnée est ennemie par rapport à la couleur spécifiée.
-         * @param sq Index de la case (0-63)
-         * @param whitePiece true si la pièce de référence est blanche, false si noire
-         * @return true si la pièce sur la case est adverse, false sinon.
-         */
-        bool isEnemy(int sq, bool whitePiece) const;
-        
-        /**
-         * @brief Génère les déplacements "bruts" possibles pour une pièce à une case donnée.
-         * 
-         * Ces mouvements ne tiennent pas compte de la mise en échec du roi ni d'autres règles avancées.
-         * 
-         * @param piece La pièce concernée.
-         * @param from La case d'origine (0-63).
-         * @return Vecteur d'indices de cases accessibles.
+         * @brief Applique un coup validé choisi depuis l'interface (cases + pièce de promotion).
+         * @param from Case d'origine (0-63).
+         * @param to Case de destination (0-63).
+         * @param promotion Pièce choisie si le coup est une promotion, PieceType::None sinon.
          */
-        std::vector<int> getRawMoves(const Piece& piece, int from) const;
+        void commitMove(int from, int to, PieceType promotion);
         
-        int fiftyMoveCounter; // Compteur pour la règle des 50 coups
-        std::vector<uint64_t> positionHistory; // Historique des hashs de position pour la répétition
-        uint64_t currentZobristHash; // Hash Zobrist de la position actuelle
+        /// Historique des hashs de position pour la répétition, un par snapshot (même index)
+        std::vector<uint64_t> positionHistory;
 
-        // Fonctions d'aide pour Zobrist Hashing (à implémenter)
-        void generateZobristKeys();
-        uint64_t calculateZobristHash() const;
-        void updateZobristHashForMove(const Piece& movingPiece, int from, int to, const Piece& capturedPiece, int capturedPawnSq, bool isCastling, int rookFrom = -1, int rookTo = -1, PieceType promotionType = PieceType::None);
+        // Historique et captures
+        /// Un point de contrôle (position complète) est conservé tous les CHECKPOINT_INTERVAL demi-coups
+        static constexpr int CHECKPOINT_INTERVAL = 32;
 
-        std::map<std::string, uint64_t> ZobristPieceKeys[64]; // [square][piece_name] -> hash
-        uint64_t ZobristSideToMoveKey; // hash pour le trait (blanc/noir)
-        uint64_t ZobristCastlingKeys[16]; // hash pour les droits de roque (4 bits, 16 combinaisons)
-        uint64_t ZobristEnPassantKeys[8]; // hash pour la colonne de prise en passant (8 colonnes)
+        /// Coups joués depuis le début de la partie (2 octets par demi-coup) : le coup i mène du snapshot i au i+1
+        std::vector<Move> plyMoves;
+
+        /// Positions complètes aux demi-coups 0, CHECKPOINT_INTERVAL, 2 * CHECKPOINT_INTERVAL, ...
+        std::vector<Position> checkpoints;
 
-        // Historique et captures
-        std::vector<Snapshot> snapshots;
         int currentSnapshotIndex = 0;
-        std::vector<std::string> moveHistory; // Notation PGN/SAN
-        std::vector<Piece> capturedByWhite;   // Pièces noires capturées
-        std::vector<Piece> capturedByBlack;   // Pièces blanches capturées
 
-        Snapshot createSnapshot() const;
-        std::string generatePGNMove(int from, int to, const Piece& movingPiece, bool isCapture, bool isCheck, bool isCheckmate) const;
+        /// Numéro du coup de la position de départ (1, ou celui lu dans la FEN chargée)
+        int startFullmoveNumber = 1;
+
+        /// Repart d'un historique vide dont la position courante est le snapshot 0
+        void resetHistory();
+
+        // Notation et captures, calculées à la demande à partir de plyMoves (voir updateMoveNotation)
+        mutable std::vector<std::string> moveHistory; // Notation PGN/SAN
+        mutable std::vector<Piece> capturedByWhite;   // Pièces noires capturées
+        mutable std::vector<Piece> capturedByBlack;   // Pièces blanches capturées
+
+        /**
+         * @brief Complète la notation SAN et les listes de captures pour les coups qui n'en ont pas encore.
+         * Les coups manquants sont rejoués depuis le point de contrôle qui les précède : le coût
+         * (échec, mat, notation) n'est payé qu'une fois par coup, et seulement si l'interface le demande.
+         */
+        void updateMoveNotation() const;
+
+        // État de la partie mis en cache : recalculé seulement quand la position ou l'index dans l'historique change
+        mutable ChessGameStatus cachedStatus = ChessGameStatus::Playing;
+        mutable uint64_t cachedStatusHash = 0ULL;
+        mutable int cachedStatusPly = -1; ///< -1 : cache invalide
+
+        /// Invalide l'état de la partie mis en cache (appelé à chaque changement de position)
+        void invalidateGameState() { cachedStatusPly = -1; }
 
     public:
         /**
@@ -142,7 +104,35 @@ namespace Jr {
          * @param square Index de la case (0-63)
          * @return Objet Piece représentant la pièce, ou une pièce "vide" si aucune.
          */
-        Piece getPieceAtSquare(int square) const;
+        Piece getPieceAtSquare(int square) const { return position.getPieceAtSquare(square); }
+
+        /**
+         * @brief Retourne la position courante, sans historique ni état d'interface.
+         * Trivialement copiable : c'est ce qu'on transmet à l'IA.
+         * @return Référence constante vers la position.
+         */
+        const Position& getPosition() const { return position; }
+
+        /**
+         * @brief Retourne le bitboard d'un type de pièce donné.
+         * @param code Code de la pièce (ex: WhiteKnight).
+         * @return Bitboard des cases occupées par ce type de pièce.
+         */
+        uint64_t getPieceBitboard(PieceCode code) const { return position.getPieceBitboard(code); }
+
+        /**
+         * @brief Retourne le code de la pièce présente sur une case (lecture directe de la mailbox).
+         * @param square Index de la case (0-63).
+         * @return Code de la pièce, ou NoPiece si la case est vide.
+         */
+        PieceCode getPieceCodeAt(int square) const { return position.getPieceCodeAt(square); }
+
+        /**
+         * @brief Retourne le bitboard des cases occupées par une couleur.
+         * @param color Couleur des pièces (White ou Black).
+         * @return Bitboard d'occupation de cette couleur.
+         */
+        uint64_t getColorBitboard(PieceColor color) const { return position.getColorBitboard(color); }
 
         /**
          * @brief Constructeur par défaut.
@@ -156,6 +146,18 @@ namespace Jr {
          */
         void initializeBoard();
 
+        /**
+         * @brief Charge une position au format FEN ; l'historique repart de cette position.
+         * @param fen Chaîne FEN (les compteurs de fin sont facultatifs).
+         * @return true si la chaîne est valide, false sinon (la partie en cours est conservée).
+         */
+        bool loadFEN(const std::string& fen);
+
+        /**
+         * @brief Retourne la position courante au format FEN, numéro du coup compris.
+         */
+        std::string getFEN() const;
+
         /**
          * @brief Vérifie si un mouvement est valide selon les règles du jeu.
          * 
@@ -170,27 +172,49 @@ namespace Jr {
         /**
          * @brief Effectue un coup valide et met à jour l'état du jeu.
          * 
-         * Met à jour les bitboards, le tour, les droits au roque, prise en passant, promotion, etc.
+         * Met à jour les bitboards, le tour, les droits au roque, prise en passant, etc.
+         * Une promotion est différée : le coup est mis en attente (isPromotionPending) sans changer
+         * le plateau, le trait ni l'historique, et n'est joué qu'une fois la pièce choisie via promotePawn.
+         * Aucun autre coup n'est accepté tant que la promotion est en attente.
          * 
          * @param from Case d'origine (0-63).
          * @param to Case de destination (0-63).
-         * @return true si le mouvement a été effectué avec succès, false sinon (ex: coup illégal).
+         * @return true si le mouvement a été effectué (ou mis en attente de promotion), false sinon (ex: coup illégal).
          */
         bool makeMove(int from, int to);
-        
+
+        /**
+         * @brief Joue un coup supposé légal, sans validation ni notation (IA, perft, chargement de partie).
+         *
+         * Seuls la position, l'historique des coups et les hashs de répétition sont mis à jour :
+         * la notation SAN et les captures seront calculées plus tard si getMoveHistory() est appelée.
+         * Aucune promotion ne doit être en attente.
+         *
+         * @param move Coup encodé pour la position courante (voir Position::encodeMove).
+         */
+        void applyTrustedMove(Move move);
+
         /**
          * @brief Retourne la liste des coups légaux pour la pièce située à la case donnée.
          * @param from Case de la pièce (0-63).
          * @return Vecteur des cases accessibles légalement.
          */
-        std::vector<int> getLegalMoves(int from) const;
+        std::vector<int> getLegalMoves(int from) const { return position.getLegalMoves(from); }
 
         /**
          * @brief Indique si le roi de la couleur spécifiée est en échec.
          * @param whiteKing true pour roi blanc, false pour roi noir.
          * @return true si le roi est en échec, false sinon.
          */
-        bool isKingInCheck(bool whiteKing) const;
+        bool isKingInCheck(bool whiteKing) const { return position.isKingInCheck(whiteKing); }
+
+        /**
+         * @brief Indique si une case est attaquée par une couleur (quelques lectures de tables).
+         * @param square Case visée (0-63).
+         * @param byWhite true pour les attaques blanches, false pour les noires.
+         * @return true si au moins une pièce de cette couleur attaque la case.
+         */
+        bool isSquareAttacked(int square, bool byWhite) const { return position.isSquareAttacked(square, byWhite); }
 
         /**
          * @brief Vérifie si un coup hypothétique mettrait le roi en échec.
@@ -202,13 +226,13 @@ namespace Jr {
          * @param whiteKing Couleur du roi à protéger (true = blanc).
          * @return true si le roi serait en échec après ce coup, false sinon.
          */
-        bool wouldBeInCheck(int from, int to, bool whiteKing) const;
+        bool wouldBeInCheck(int from, int to, bool whiteKing) const { return position.wouldBeInCheck(from, to, whiteKing); }
 
         /**
          * @brief Obtient le tour actuel.
          * @return true si c'est le tour des blancs, false pour les noirs.
          */
-        bool getWhiteTurn() const { return whiteTurn; }
+        bool getWhiteTurn() const { return position.whiteTurn; }
 
         /**
          * @brief Indique si une promotion est en attente de choix.
@@ -230,6 +254,8 @@ namespace Jr {
         
         /**
          * @brief Effectue la promotion d'un pion à une case donnée vers un nouveau type de pièce.
+         * Joue le coup mis en attente par makeMove avec la pièce choisie : il entre alors dans l'historique
+         * (notation "e8=N" par exemple) et le trait passe à l'adversaire.
          * @param square Case où la promotion doit avoir lieu (0-63).
          * @param newType Type de pièce choisie pour la promotion (ex: Dame, Tour, Fou, Cavalier).
          */
@@ -248,7 +274,8 @@ namespace Jr {
          * @brief Vérifie si le jeu est terminé (échec, pat, etc.).
          * 
          * Cette méthode évalue l'état du jeu pour déterminer s'il y a un gagnant,
-         * un match nul, ou si le jeu continue.
+         * un match nul, ou si le jeu continue. Le résultat est calculé une fois par position
+         * (clé : hash et index dans l'historique) puis relu depuis le cache à chaque image.
          * 
          * @return L'état actuel du jeu (en cours, échec et mat, pat, etc.).
          */
@@ -264,7 +291,7 @@ namespace Jr {
          * @brief Vérifie si la partie est un match nul par matériel insuffisant.
          * @return True si c'est un draw par matériel, False sinon.
          */
-        bool isInsufficientMaterial() const;
+        bool isInsufficientMaterial() const { return position.isInsufficientMaterial(); }
 
         /**
          * @brief Vérifie si la partie est un match nul par la règle des 50 coups sans capture ni mouvement de pion.
@@ -278,15 +305,28 @@ namespace Jr {
          */
         bool isThreeFoldRepetitionDraw() const;
 
-        bool noLegalMovesAvailable(bool whiteToMove) const;
+        /**
+         * @brief Retourne les hashs des positions depuis le dernier coup irréversible, position courante comprise.
+         * C'est tout ce dont la recherche a besoin pour reconnaître une répétition avec l'historique de la partie.
+         * @return Hashs du plus ancien au plus récent.
+         */
+        std::vector<uint64_t> getRepetitionHistory() const;
+
+        bool noLegalMovesAvailable(bool whiteToMove) const { return position.noLegalMovesAvailable(whiteToMove); }
         bool isCheckmate(bool whiteToMove) const;
 
         // API pour l'historique, captures et navigation
-        const std::vector<std::string>& getMoveHistory() const { return moveHistory; }
-        const std::vector<Piece>& getCapturedByWhite() const { return capturedByWhite; }
-        const std::vector<Piece>& getCapturedByBlack() const { return capturedByBlack; }
-        int getSnapshotCount() const { return static_cast<int>(snapshots.size()); }
+        const std::vector<std::string>& getMoveHistory() const { updateMoveNotation(); return moveHistory; }
+        const std::vector<Piece>& getCapturedByWhite() const { updateMoveNotation(); return capturedByWhite; }
+        const std::vector<Piece>& getCapturedByBlack() const { updateMoveNotation(); return capturedByBlack; }
+        int getSnapshotCount() const { return static_cast<int>(plyMoves.size()) + 1; }
         int getCurrentSnapshotIndex() const { return currentSnapshotIndex; }
+        /**
+         * @brief Revient à la position après `index` demi-coups, en rejouant au plus
+         * CHECKPOINT_INTERVAL - 1 coups depuis le point de contrôle le plus proche.
+         * @param index Numéro du snapshot (0 = position initiale).
+         * @return false si l'index est hors de l'historique.
+         */
         bool restoreSnapshot(int index);
         int getMaterialScoreDifference() const;
     };
@@ -0,0 +1,30 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace Jr {
+
+    /**
+     * @file Epd.hpp
+     * @brief Lecture des enregistrements EPD (Extended Position Description) des suites de tests tactiques.
+     *
+     * Une ligne EPD contient les quatre premiers champs d'une FEN suivis d'opérations "opcode opérandes;",
+     * par exemple : `r1b1k2r/... w kq - bm Qxf7+; id "WAC.001";`.
+     */
+
+    /// Position EPD et opérations utiles au test d'un moteur
+    struct EpdRecord {
+        std::string fen;                     ///< FEN complète (compteurs ajoutés : "0 1" sauf opérations hmvc/fmvn)
+        std::string id;                      ///< Opération "id", vide si absente
+        std::vector<std::string> bestMoves;  ///< Opération "bm" : coups attendus (SAN)
+        std::vector<std::string> avoidMoves; ///< Opération "am" : coups à éviter (SAN)
+    };
+
+    /**
+     * @brief Analyse une ligne EPD.
+     * @param line Ligne du fichier (les lignes vides ou commençant par '#' sont rejetées).
+     * @param record Reçoit la position et les opérations lues.
+     * @return true si la ligne contient au moins les quatre champs de position.
+     */
+    bool parseEpdLine(const std::string& line, EpdRecord& record);
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include "Piece.hpp"
+
+namespace Jr {
+
+    /**
+     * @file Move.hpp
+     * @brief Représentation compacte d'un coup (16 bits) et liste de coups de capacité fixe.
+     *
+     * Disposition des bits : case de départ (bits 0-5), case d'arrivée (bits 6-11), drapeaux (bits 12-15).
+     * Dans les drapeaux, le bit 2 signale une capture et le bit 3 une promotion ; les deux bits bas
+     * d'une promotion donnent la pièce choisie (cavalier, fou, tour, dame).
+     */
+
+    /// Drapeaux d'un coup, sur 4 bits
+    enum MoveFlag : uint8_t {
+        QuietMove              = 0,
+        DoublePawnPush         = 1,
+        KingCastle             = 2,
+        QueenCastle            = 3,
+        CaptureMove            = 4,
+        EnPassantCapture       = 5,
+        KnightPromotion        = 8,
+        BishopPromotion        = 9,
+        RookPromotion          = 10,
+        QueenPromotion         = 11,
+        KnightPromotionCapture = 12,
+        BishopPromotionCapture = 13,
+        RookPromotionCapture   = 14,
+        QueenPromotionCapture  = 15
+    };
+
+    /**
+     * @class Move
+     * @brief Coup encodé sur 16 bits (départ, arrivée, drapeaux).
+     *
+     * Le constructeur par défaut laisse le coup non initialisé pour que les listes de coups
+     * ne coûtent rien à construire ; utiliser Move::none() pour un coup nul explicite.
+     */
+    class Move {
+    public:
+        Move() = default;
+
+        constexpr Move(int from, int to, MoveFlag flag = QuietMove)
+            : data(static_cast<uint16_t>(from | (to << 6) | (flag << 12))) {}
+
+        /// Coup nul (a1 -> a1), utilisé comme valeur "aucun coup"
+        static constexpr Move none() { return Move(0, 0); }
+
+        /// Reconstruit un coup à partir de sa valeur brute (voir raw())
+        static constexpr Move fromRaw(uint16_t raw) {
+            Move move = none();
+            move.data = raw;
+            return move;
+        }
+
+        constexpr int from() const { return data & 0x3F; }
+        constexpr int to() const { return (data >> 6) & 0x3F; }
+        constexpr MoveFlag flag() const { return static_cast<MoveFlag>(data >> 12); }
+        constexpr uint16_t raw() const { return data; }
+
+        constexpr bool isCapture() const { return (data >> 12) & CaptureMove; }
+        constexpr bool isPromotion() const { return (data >> 12) & KnightPromotion; }
+        constexpr bool isCastle() const { return flag() == KingCastle || flag() == QueenCastle; }
+        constexpr bool isEnPassant() const { return flag() == EnPassantCapture; }
+
+        /// Pièce choisie pour une promotion, PieceType::None pour les autres coups
+        constexpr PieceType promotionType() const {
+            return isPromotion() ? static_cast<PieceType>(static_cast<int>(PieceType::Knight) + (flag() & 3))
+                                 : PieceType::None;
+        }
+
+        /// Notation UCI du coup (ex: "e2e4", "e7e8q")
+        std::string toUci() const {
+            std::string text{char('a' + from() % 8), char('1' + from() / 8), char('a' + to() % 8), char('1' + to() / 8)};
+            if (isPromotion()) text += "nbrq"[flag() & 3];
+            return text;
+        }
+
+        constexpr bool operator==(const Move& other) const { return data == other.data; }
+        constexpr bool operator!=(const Move& other) const { return data != other.data; }
+
+    private:
+        uint16_t data;
+    };
+
+    /**
+     * @struct MoveList
+     * @brief Liste de coups allouée sur la pile, de capacité suffisante pour toute position légale.
+     */
+    struct MoveList {
+        static constexpr int MAX_MOVES = 256;
+
+        std::array<Move, MAX_MOVES> moves;
+        int count = 0;
+
+        void add(Move move) { moves[count++] = move; }
+        void clear() { count = 0; }
+        int size() const { return count; }
+        bool empty() const { return count == 0; }
+
+        Move& operator[](int i) { return moves[i]; }
+        const Move& operator[](int i) const { return moves[i]; }
+
+        Move* begin() { return moves.data(); }
+        Move* end() { return moves.data() + count; }
+        const Move* begin() const { return moves.data(); }
+        const Move* end() const { return moves.data() + count; }
+    };
+
+    static_assert(sizeof(Move) == 2, "Un coup doit tenir sur 16 bits");
+    static_assert(Move(12, 28, DoublePawnPush).from() == 12 && Move(12, 28, DoublePawnPush).to() == 28,
+                  "Encodage des coups incorrect");
+    static_assert(Move(52, 60, QueenPromotion).promotionType() == PieceType::Queen, "Encodage des promotions incorrect");
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Move.hpp"
+#include "Position.hpp"
+
+namespace Jr {
+
+    /**
+     * @file MovePicker.hpp
+     * @brief Ordre d'essai des coups dans la recherche : coup de la table, captures, coups "killer", historique.
+     *
+     * L'élagage alpha-bêta coupe d'autant plus que le meilleur coup est essayé tôt. Tous les coups légaux
+     * sont notés une fois, puis rendus du meilleur au moins bon par sélection : une coupure au premier
+     * coup évite de trier le reste de la liste.
+     */
+
+    /// Deux coups tranquilles ayant provoqué une coupure à un même ply dans des positions sœurs
+    using KillerMoves = std::array<Move, 2>;
+
+    /**
+     * @class HistoryTable
+     * @brief Historique "papillon" : succès des coups tranquilles, indexés par [camp][départ][arrivée].
+     */
+    class HistoryTable {
+    public:
+        /// Valeur maximale d'une entrée, en dessous des notes des coups killer
+        static constexpr int MAX_SCORE = 1 << 16;
+
+        /// Récompense un coup tranquille qui a provoqué une coupure (bonus croissant avec la profondeur)
+        void reward(bool white, Move move, int depth);
+
+        int get(bool white, Move move) const { return table[white ? 0 : 1][move.from()][move.to()]; }
+
+        /// Divise toutes les entrées par deux : les nouvelles recherches pèsent plus que les anciennes
+        void age();
+
+        void clear() { table = {}; }
+
+    private:
+        std::array<std::array<std::array<int32_t, 64>, 64>, 2> table{};
+    };
+
+    /**
+     * @class MovePicker
+     * @brief Rend les coups légaux d'un nœud dans l'ordre : coup de la table de transposition,
+     * captures et promotions par MVV-LVA (victime la plus chère, attaquant le moins cher),
+     * deux coups killer, puis coups tranquilles selon l'historique.
+     */
+    class MovePicker {
+    public:
+        /// Note chaque coup de `moves` (la liste est réordonnée sur place au fil des appels à next())
+        MovePicker(const Position& position, MoveList& moves, Move hashMove, const KillerMoves& killers,
+                   const HistoryTable& history);
+
+        /// Coup suivant dans l'ordre ; false quand tous les coups ont été rendus
+        bool next(Move& move);
+
+        /// Vrai si le coup n'est ni une capture ni une promotion (candidat killer et historique)
+        static bool isQuiet(Move move) { return !move.isCapture() && !move.isPromotion(); }
+
+    private:
+        static constexpr int HASH_MOVE_SCORE = 1 << 30;
+        static constexpr int CAPTURE_SCORE = 1 << 20;
+        static constexpr int FIRST_KILLER_SCORE = HistoryTable::MAX_SCORE + 2;
+        static constexpr int SECOND_KILLER_SCORE = HistoryTable::MAX_SCORE + 1;
+        /// Les sous-promotions passent après tous les coups tranquilles
+        static constexpr int UNDERPROMOTION_SCORE = -1;
+
+        MoveList& moves;
+        std::array<int, MoveList::MAX_MOVES> scores;
+        int current = 0;
+    };
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+#include "Move.hpp"
+#include "Position.hpp"
+
+namespace Jr {
+
+    /**
+     * @file Notation.hpp
+     * @brief Conversion entre coups encodés et notation algébrique standard (SAN).
+     */
+
+    /**
+     * @brief Écrit un coup légal en SAN, avec désambiguïsation et suffixe d'échec ("Nbd7", "exd6", "O-O+", "e8=Q#").
+     *
+     * Le suffixe est déterminé après le coup, pour le camp qui a alors le trait : "+" s'il est en échec,
+     * "#" s'il est en échec sans coup légal.
+     * @param position Position avant le coup.
+     * @param move Coup légal dans cette position.
+     */
+    std::string moveToSAN(const Position& position, Move move);
+
+    /**
+     * @brief Retrouve le coup légal correspondant à une chaîne SAN (ou UCI, ex: "e2e4").
+     *
+     * Les suffixes "+", "#", "!" et "?" sont ignorés, ainsi que "0-0" écrit avec des zéros.
+     *
+     * @param position Position dans laquelle le coup est joué.
+     * @param text Coup en notation SAN ou UCI.
+     * @return Le coup, ou Move::none() si aucun coup légal ne correspond.
+     */
+    Move moveFromSAN(const Position& position, const std::string& text);
+}
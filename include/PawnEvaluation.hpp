@@ -0,0 +1,103 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Bitboard.hpp"
+#include "Position.hpp"
+
+namespace Jr {
+
+    /**
+     * @file PawnEvaluation.hpp
+     * @brief Évaluation de la structure de pions (pions passés, doublés, isolés, arriérés)
+     * et table de hachage qui la mémorise par structure.
+     *
+     * La structure de pions change rarement d'un nœud à l'autre : l'évaluation complète n'est faite
+     * qu'en cas d'échec de la table, indexée par Position::pawnHash.
+     */
+
+    /// Score de structure de pions, du point de vue des blancs, pour chaque phase
+    struct PawnScore {
+        int16_t middlegame = 0;
+        int16_t endgame = 0;
+    };
+
+    namespace detail {
+
+        /// Colonnes voisines de chaque colonne
+        constexpr std::array<uint64_t, 8> makeAdjacentFiles() {
+            std::array<uint64_t, 8> masks{};
+            for (int file = 0; file < 8; ++file) {
+                if (file > 0) masks[file] |= FILE_A << (file - 1);
+                if (file < 7) masks[file] |= FILE_A << (file + 1);
+            }
+            return masks;
+        }
+
+        /**
+         * @brief Cases devant un pion, sur sa colonne et les deux voisines, jusqu'à la promotion.
+         * Un pion est passé si aucun pion adverse ne s'y trouve. Indexé par [couleur][case].
+         */
+        constexpr std::array<std::array<uint64_t, 64>, 2> makePassedPawnMasks() {
+            std::array<std::array<uint64_t, 64>, 2> masks{};
+            for (int sq = 0; sq < 64; ++sq) {
+                int file = sq % 8, rank = sq / 8;
+                for (int f = file - 1; f <= file + 1; ++f) {
+                    if (f < 0 || f > 7) continue;
+                    for (int r = rank + 1; r < 8; ++r) masks[0][sq] |= squareBit(r * 8 + f);
+                    for (int r = rank - 1; r >= 0; --r) masks[1][sq] |= squareBit(r * 8 + f);
+                }
+            }
+            return masks;
+        }
+    }
+
+    /// Masques des colonnes voisines, indexés par colonne
+    inline constexpr std::array<uint64_t, 8> ADJACENT_FILES = detail::makeAdjacentFiles();
+
+    /// Zones devant chaque pion qui doivent être libres de pions adverses pour qu'il soit passé
+    inline constexpr std::array<std::array<uint64_t, 64>, 2> PASSED_PAWN_MASKS = detail::makePassedPawnMasks();
+
+    static_assert(ADJACENT_FILES[0] == (FILE_A << 1) && PASSED_PAWN_MASKS[0][52] == 0x3800000000000000ULL,
+                  "Masques de structure de pions incorrects");
+
+    /**
+     * @brief Évalue complètement la structure de pions (sans table).
+     * @return Bonus et pénalités des deux camps, blancs moins noirs, en centipions.
+     */
+    PawnScore evaluatePawnStructure(const Position& position);
+
+    /**
+     * @class PawnHashTable
+     * @brief Table de hachage des évaluations de structure de pions, propre à un thread de recherche.
+     *
+     * Remplacement systématique : la structure courante remplace celle qui occupait l'entrée.
+     * Les compteurs d'accès permettent de vérifier le taux de réussite (attendu au-delà de 95 %).
+     */
+    class PawnHashTable {
+    public:
+        /// Nombre d'entrées par défaut (16 octets chacune : 256 Ko)
+        static constexpr size_t DEFAULT_ENTRIES = 1 << 14;
+
+        explicit PawnHashTable(size_t entryCount = DEFAULT_ENTRIES);
+
+        /// Score de la structure de pions de la position, lu dans la table ou calculé puis mémorisé
+        PawnScore probe(const Position& position);
+
+        uint64_t getProbes() const { return probes; }
+        uint64_t getHits() const { return hits; }
+        void resetCounters() { probes = hits = 0; }
+
+    private:
+        struct Entry {
+            uint64_t key = 0ULL;
+            PawnScore score;
+            bool valid = false;
+        };
+
+        std::vector<Entry> entries;
+        uint64_t mask;
+        uint64_t probes = 0;
+        uint64_t hits = 0;
+    };
+}
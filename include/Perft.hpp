@@ -0,0 +1,89 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Move.hpp"
+#include "Position.hpp"
+
+namespace Jr {
+
+    /**
+     * @file Perft.hpp
+     * @brief Comptage des nœuds de l'arbre des coups légaux (perft), pour vérifier et mesurer le générateur.
+     *
+     * Un perft compte les feuilles de l'arbre à une profondeur donnée ; comparé aux valeurs de référence
+     * publiées, il valide toutes les règles (roque, prise en passant, promotions, clouages, échecs).
+     */
+
+    /// Position de référence avec son nombre de nœuds connu
+    struct PerftReferencePosition {
+        const char* name;
+        const char* fen;
+        int depth;
+        uint64_t nodes;
+    };
+
+    /// Positions standard (chessprogramming.org, "Perft Results"), à des profondeurs de quelques secondes
+    inline constexpr std::array<PerftReferencePosition, 6> PERFT_REFERENCE_POSITIONS = {{
+        {"initiale", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 6, 119060324ULL},
+        {"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 5, 193690690ULL},
+        {"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083ULL},
+        {"position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292ULL},
+        {"position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 5, 89941194ULL},
+        {"position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 5, 164075551ULL},
+    }};
+
+    /**
+     * @class PerftTable
+     * @brief Table de hachage des sous-arbres déjà comptés, partageable entre threads sans verrou.
+     *
+     * Chaque entrée stocke (clé XOR données, données) : une lecture concurrente mêlant deux écritures
+     * ne vérifie pas le XOR et est simplement ignorée. Les données regroupent le nombre de nœuds
+     * (56 bits) et la profondeur (8 bits), la profondeur faisant partie de la clé.
+     */
+    class PerftTable {
+    public:
+        /// Alloue la table (taille arrondie à la puissance de deux inférieure)
+        explicit PerftTable(size_t megabytes);
+
+        bool probe(uint64_t hash, int depth, uint64_t& nodes) const;
+        void store(uint64_t hash, int depth, uint64_t nodes);
+
+    private:
+        struct Entry {
+            std::atomic<uint64_t> check{0}; ///< hash XOR data
+            std::atomic<uint64_t> data{0};  ///< (nœuds << 8) | profondeur
+        };
+
+        std::unique_ptr<Entry[]> entries;
+        uint64_t mask = 0;
+    };
+
+    /// Nombre de nœuds pour un coup racine (sortie "divide")
+    struct PerftDivideEntry {
+        Move move;
+        uint64_t nodes;
+    };
+
+    /**
+     * @brief Compte les feuilles de l'arbre des coups légaux à la profondeur donnée.
+     * Au dernier niveau, la taille de la liste de coups suffit (comptage "bulk").
+     * @param position Position de départ (restaurée à l'identique en sortie).
+     * @param depth Profondeur en demi-coups.
+     * @param table Table de hachage facultative (nullptr pour un perft sans table).
+     */
+    uint64_t perft(Position& position, int depth, PerftTable* table = nullptr);
+
+    /**
+     * @brief Perft détaillé par coup racine, les coups racine étant répartis entre plusieurs threads.
+     * @param position Position de départ.
+     * @param depth Profondeur en demi-coups (au moins 1).
+     * @param threads Nombre de threads de travail (au moins 1).
+     * @param table Table de hachage facultative, partagée par tous les threads.
+     * @return Un élément par coup légal, dans l'ordre de génération.
+     */
+    std::vector<PerftDivideEntry> perftDivide(const Position& position, int depth, int threads, PerftTable* table = nullptr);
+}
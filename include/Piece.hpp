@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <utility>
 
@@ -29,6 +30,41 @@ enum class PieceColor {
     None   /**< Aucune couleur (case vide) */
 };
 
+/**
+ * @enum PieceCode
+ * @brief Code compact d'une pièce (couleur * 6 + type), utilisé pour indexer directement les bitboards.
+ *
+ * L'ordre suit celui de PieceType et PieceColor, ce qui permet de passer de l'un à l'autre
+ * par une simple opération arithmétique.
+ */
+enum PieceCode : uint8_t {
+    WhitePawn, WhiteKnight, WhiteBishop, WhiteRook, WhiteQueen, WhiteKing,
+    BlackPawn, BlackKnight, BlackBishop, BlackRook, BlackQueen, BlackKing,
+    NoPiece /**< Aucune pièce (case vide) */
+};
+
+/// Nombre de codes de pièces valides (6 types x 2 couleurs)
+inline constexpr int PIECE_CODE_COUNT = 12;
+
+/**
+ * @brief Construit le code compact d'une pièce à partir de son type et de sa couleur.
+ * @return Le code correspondant, ou NoPiece si le type ou la couleur est None.
+ */
+constexpr PieceCode makePieceCode(PieceType t, PieceColor c) {
+    if (t == PieceType::None || c == PieceColor::None) return NoPiece;
+    return static_cast<PieceCode>(static_cast<int>(c) * 6 + static_cast<int>(t));
+}
+
+/// Type de la pièce désignée par un code (PieceType::None pour NoPiece)
+constexpr PieceType pieceCodeType(PieceCode code) {
+    return code == NoPiece ? PieceType::None : static_cast<PieceType>(code % 6);
+}
+
+/// Couleur de la pièce désignée par un code (PieceColor::None pour NoPiece)
+constexpr PieceColor pieceCodeColor(PieceCode code) {
+    return code == NoPiece ? PieceColor::None : static_cast<PieceColor>(code / 6);
+}
+
 /**
  * @struct Piece
  * @brief Structure représentant une pièce d'échecs logique (sans aspects graphiques).
@@ -54,6 +90,22 @@ struct Piece {
      */
     Piece(PieceType t, PieceColor c) : type(t), color(c) {}
 
+    /**
+     * @brief Construit une pièce à partir de son code compact.
+     * @param code Code de la pièce (NoPiece donne une pièce vide)
+     */
+    static Piece fromCode(PieceCode code) {
+        return Piece(pieceCodeType(code), pieceCodeColor(code));
+    }
+
+    /**
+     * @brief Retourne le code compact de la pièce, utilisable comme index de bitboard.
+     * @return Code de la pièce ou NoPiece si la pièce est vide.
+     */
+    PieceCode code() const {
+        return makePieceCode(type, color);
+    }
+
     /**
      * @brief Indique si cette pièce est vide (pas de pièce).
      * @return true si la pièce est vide, false sinon.
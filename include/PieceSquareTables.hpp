@@ -0,0 +1,147 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "Piece.hpp"
+
+namespace Jr {
+
+    /**
+     * @file PieceSquareTables.hpp
+     * @brief Valeurs des pièces, tables pièce-case de milieu et de fin de partie, et poids de phase,
+     * tous calculés à la compilation.
+     *
+     * Les scores sont en centipions, du point de vue du propriétaire de la pièce (positif = bon pour lui).
+     * Position les additionne incrémentalement à chaque pose, retrait ou déplacement de pièce ;
+     * l'évaluation mélange ensuite les deux phases selon le matériel restant (évaluation "tapered").
+     */
+
+    /// Valeur matérielle de chaque type de pièce (indexée par PieceType), en centipions
+    inline constexpr std::array<int16_t, 6> PIECE_VALUES = {100, 320, 330, 500, 900, 0};
+
+    /// Poids de chaque type de pièce dans la phase de jeu (cavalier/fou 1, tour 2, dame 4)
+    inline constexpr std::array<uint8_t, 6> PHASE_WEIGHTS = {0, 1, 1, 2, 4, 0};
+
+    /// Phase de la position initiale : pur milieu de partie. 0 = pure finale
+    inline constexpr int MAX_PHASE = 24;
+
+    namespace detail {
+
+        using SquareTable = std::array<int16_t, 64>;
+
+        /*
+         * Tables vues par les blancs, écrites comme un diagramme : la première ligne est la 8ème rangée.
+         * Milieu de partie : tables "Simplified Evaluation Function" (T. Michniewski).
+         */
+        inline constexpr std::array<SquareTable, 6> MIDDLEGAME_TABLES = {{
+            { // Pion
+                  0,   0,   0,   0,   0,   0,   0,   0,
+                 50,  50,  50,  50,  50,  50,  50,  50,
+                 10,  10,  20,  30,  30,  20,  10,  10,
+                  5,   5,  10,  25,  25,  10,   5,   5,
+                  0,   0,   0,  20,  20,   0,   0,   0,
+                  5,  -5, -10,   0,   0, -10,  -5,   5,
+                  5,  10,  10, -20, -20,  10,  10,   5,
+                  0,   0,   0,   0,   0,   0,   0,   0 },
+            { // Cavalier
+                -50, -40, -30, -30, -30, -30, -40, -50,
+                -40, -20,   0,   0,   0,   0, -20, -40,
+                -30,   0,  10,  15,  15,  10,   0, -30,
+                -30,   5,  15,  20,  20,  15,   5, -30,
+                -30,   0,  15,  20,  20,  15,   0, -30,
+                -30,   5,  10,  15,  15,  10,   5, -30,
+                -40, -20,   0,   5,   5,   0, -20, -40,
+                -50, -40, -30, -30, -30, -30, -40, -50 },
+            { // Fou
+                -20, -10, -10, -10, -10, -10, -10, -20,
+                -10,   0,   0,   0,   0,   0,   0, -10,
+                -10,   0,   5,  10,  10,   5,   0, -10,
+                -10,   5,   5,  10,  10,   5,   5, -10,
+                -10,   0,  10,  10,  10,  10,   0, -10,
+                -10,  10,  10,  10,  10,  10,  10, -10,
+                -10,   5,   0,   0,   0,   0,   5, -10,
+                -20, -10, -10, -10, -10, -10, -10, -20 },
+            { // Tour
+                  0,   0,   0,   0,   0,   0,   0,   0,
+                  5,  10,  10,  10,  10,  10,  10,   5,
+                 -5,   0,   0,   0,   0,   0,   0,  -5,
+                 -5,   0,   0,   0,   0,   0,   0,  -5,
+                 -5,   0,   0,   0,   0,   0,   0,  -5,
+                 -5,   0,   0,   0,   0,   0,   0,  -5,
+                 -5,   0,   0,   0,   0,   0,   0,  -5,
+                  0,   0,   0,   5,   5,   0,   0,   0 },
+            { // Dame
+                -20, -10, -10,  -5,  -5, -10, -10, -20,
+                -10,   0,   0,   0,   0,   0,   0, -10,
+                -10,   0,   5,   5,   5,   5,   0, -10,
+                 -5,   0,   5,   5,   5,   5,   0,  -5,
+                  0,   0,   5,   5,   5,   5,   0,  -5,
+                -10,   5,   5,   5,   5,   5,   0, -10,
+                -10,   0,   5,   0,   0,   0,   0, -10,
+                -20, -10, -10,  -5,  -5, -10, -10, -20 },
+            { // Roi : à l'abri derrière ses pions, roqué
+                -30, -40, -40, -50, -50, -40, -40, -30,
+                -30, -40, -40, -50, -50, -40, -40, -30,
+                -30, -40, -40, -50, -50, -40, -40, -30,
+                -30, -40, -40, -50, -50, -40, -40, -30,
+                -20, -30, -30, -40, -40, -30, -30, -20,
+                -10, -20, -20, -20, -20, -20, -20, -10,
+                 20,  20,   0,   0,   0,   0,  20,  20,
+                 20,  30,  10,   0,   0,  10,  30,  20 },
+        }};
+
+        /// Fin de partie : pions passés poussés, roi centralisé ; les autres pièces gardent leur table
+        inline constexpr std::array<SquareTable, 6> ENDGAME_TABLES = {{
+            { // Pion
+                  0,   0,   0,   0,   0,   0,   0,   0,
+                 80,  80,  80,  80,  80,  80,  80,  80,
+                 50,  50,  50,  50,  50,  50,  50,  50,
+                 30,  30,  30,  30,  30,  30,  30,  30,
+                 15,  15,  15,  15,  15,  15,  15,  15,
+                  5,   5,   5,   5,   5,   5,   5,   5,
+                  0,   0,   0,   0,   0,   0,   0,   0,
+                  0,   0,   0,   0,   0,   0,   0,   0 },
+            MIDDLEGAME_TABLES[1],
+            MIDDLEGAME_TABLES[2],
+            MIDDLEGAME_TABLES[3],
+            MIDDLEGAME_TABLES[4],
+            { // Roi : actif au centre
+                -50, -40, -30, -20, -20, -30, -40, -50,
+                -30, -20, -10,   0,   0, -10, -20, -30,
+                -30, -10,  20,  30,  30,  20, -10, -30,
+                -30, -10,  30,  40,  40,  30, -10, -30,
+                -30, -10,  30,  40,  40,  30, -10, -30,
+                -30, -10,  20,  30,  30,  20, -10, -30,
+                -30, -30,   0,   0,   0,   0, -30, -30,
+                -50, -30, -30, -30, -30, -30, -30, -50 },
+        }};
+
+        /**
+         * @brief Développe des tables "diagramme" en tables [PieceCode][case] (a1 = 0).
+         * Pour les blancs, la case a1 correspond à la dernière ligne du diagramme (sq ^ 56) ;
+         * les noirs lisent la même table en miroir vertical, c'est-à-dire directement à l'index sq.
+         */
+        constexpr std::array<SquareTable, PIECE_CODE_COUNT> expandTables(const std::array<SquareTable, 6>& tables) {
+            std::array<SquareTable, PIECE_CODE_COUNT> expanded{};
+            for (int type = 0; type < 6; ++type) {
+                for (int sq = 0; sq < 64; ++sq) {
+                    expanded[type][sq] = tables[type][sq ^ 56];
+                    expanded[type + 6][sq] = tables[type][sq];
+                }
+            }
+            return expanded;
+        }
+    }
+
+    /// Bonus de milieu de partie de chaque pièce sur chaque case, indexé par [PieceCode][case]
+    inline constexpr std::array<detail::SquareTable, PIECE_CODE_COUNT> PIECE_SQUARE_MIDDLEGAME =
+        detail::expandTables(detail::MIDDLEGAME_TABLES);
+
+    /// Bonus de fin de partie de chaque pièce sur chaque case, indexé par [PieceCode][case]
+    inline constexpr std::array<detail::SquareTable, PIECE_CODE_COUNT> PIECE_SQUARE_ENDGAME =
+        detail::expandTables(detail::ENDGAME_TABLES);
+
+    // e4 vaut autant pour un pion blanc que e5 pour un pion noir ; le roi blanc roqué (g1) est bien placé
+    static_assert(PIECE_SQUARE_MIDDLEGAME[WhitePawn][28] == PIECE_SQUARE_MIDDLEGAME[BlackPawn][36] &&
+                  PIECE_SQUARE_MIDDLEGAME[WhiteKing][6] == 30 && PIECE_SQUARE_ENDGAME[BlackKing][35] == 40,
+                  "Tables pièce-case mal orientées");
+}
@@ -75,6 +75,16 @@ private:
     std::future<AIMove> aiFuture;
     std::mutex chessLogicMutex;
 
+    /// Position (instantané et hash) sur laquelle la recherche en cours a été lancée
+    int aiRootSnapshot = -1;
+    uint64_t aiRootHash = 0;
+
+    /// Vrai si le camp au trait est joué par l'IA
+    bool isAITurn() const;
+
+    /// Lance la recherche de l'IA en arrière-plan, bornée par la pendule du camp au trait
+    void startAISearch();
+
 public:
     /**
      * @brief Constructeur de PlayingState.
@@ -0,0 +1,342 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "Move.hpp"
+#include "Piece.hpp"
+#include "PieceSquareTables.hpp"
+#include "Zobrist.hpp"
+
+namespace Jr {
+
+    /**
+     * @file Position.hpp
+     * @brief État minimal d'une position d'échecs, sans aucune donnée d'interface.
+     *
+     * Position ne contient que ce que les règles exigent (pièces, trait, roque, prise en passant,
+     * compteur des 50 coups, hash), plus les scores statiques de l'évaluation tenus à jour coup par coup :
+     * elle est trivialement copiable, si bien que la transmettre à un thread de recherche revient
+     * à une simple copie mémoire de taille fixe.
+     */
+
+    /// Droits de roque, combinables en masque de 4 bits (même ordre que les clés Zobrist de roque)
+    inline constexpr uint8_t CASTLE_WHITE_KINGSIDE  = 1;
+    inline constexpr uint8_t CASTLE_WHITE_QUEENSIDE = 2;
+    inline constexpr uint8_t CASTLE_BLACK_KINGSIDE  = 4;
+    inline constexpr uint8_t CASTLE_BLACK_QUEENSIDE = 8;
+    inline constexpr uint8_t CASTLE_ALL = 15;
+
+    /**
+     * @struct UndoInfo
+     * @brief Informations minimales pour annuler un coup joué avec Position::doMove.
+     *
+     * Tout ce qui ne peut pas être déduit du coup lui-même est sauvegardé ici :
+     * la pièce déplacée (avant promotion), la pièce capturée, les droits de roque,
+     * la case de prise en passant, le compteur des 50 coups et le hash Zobrist.
+     */
+    struct UndoInfo {
+        PieceCode movedPiece = NoPiece;    ///< Pièce déplacée, telle qu'elle était avant une éventuelle promotion
+        PieceCode capturedPiece = NoPiece; ///< Pièce capturée (y compris en passant), NoPiece sinon
+        uint8_t castlingRights = 0;        ///< Droits de roque avant le coup
+        int8_t enPassantSquare = -1;       ///< Case de prise en passant avant le coup
+        uint16_t fiftyMoveCounter = 0;     ///< Compteur des 50 coups avant le coup
+        uint64_t zobristHash = 0ULL;       ///< Hash de la position avant le coup
+    };
+
+    /**
+     * @struct Position
+     * @brief Position d'échecs compacte utilisée par les règles et par la recherche.
+     *
+     * Les bitboards (indexés par PieceCode) et la mailbox sont tenus à jour ensemble par
+     * putPiece/removePiece/movePiece, qui mettent aussi à jour le hash Zobrist incrémentalement.
+     */
+    struct Position {
+        /// Bitboards représentant la position de chaque type de pièce, indexés par PieceCode (ex: WhitePawn)
+        std::array<uint64_t, PIECE_CODE_COUNT> bitboards{};
+
+        /// Bitboards d'occupation par couleur, indexés par PieceColor (0 = blancs, 1 = noirs)
+        std::array<uint64_t, 2> colorBitboards{};
+
+        /// Bitboard représentant toutes les cases occupées par une pièce (blanche ou noire)
+        uint64_t bitboardPieces = 0ULL;
+
+        /// Hash Zobrist de la position
+        uint64_t zobristHash = 0ULL;
+
+        /// Hash Zobrist des seuls pions (clé de la table de hachage des pions), tenu à jour avec les pièces
+        uint64_t pawnHash = 0ULL;
+
+        /// Matériel de chaque camp (indexé par PieceColor), en centipions, tenu à jour avec les pièces
+        std::array<int16_t, 2> material{};
+
+        /// Sommes des bonus pièce-case de chaque camp en milieu et en fin de partie (voir PieceSquareTables.hpp)
+        std::array<int16_t, 2> pieceSquareMiddlegame{};
+        std::array<int16_t, 2> pieceSquareEndgame{};
+
+        /// Phase de jeu : somme des PHASE_WEIGHTS des pièces présentes (MAX_PHASE au départ, 0 sans pièces)
+        uint8_t phase = 0;
+
+        /// Représentation "mailbox" : code de la pièce présente sur chaque case (NoPiece si vide),
+        /// tenue à jour en parallèle des bitboards pour répondre en temps constant à "qui est sur la case X"
+        std::array<PieceCode, 64> mailbox{};
+
+        /// Compteur de demi-coups pour la règle des 50 coups
+        uint16_t fiftyMoveCounter = 0;
+
+        /// Index de la case cible d'une prise en passant possible, ou -1 si aucune
+        int8_t enPassantSquare = -1;
+
+        /// Droits de roque encore disponibles (masque de CASTLE_WHITE_KINGSIDE, ...).
+        /// Un droit est perdu dès que le roi ou la tour concernée quitte sa case, ou que la tour est capturée.
+        uint8_t castlingRights = CASTLE_ALL;
+
+        /// Indique si c'est au tour des blancs de jouer (true) ou des noirs (false)
+        bool whiteTurn = true;
+
+        /**
+         * @brief Place les pièces dans la position de départ standard et réinitialise l'état.
+         */
+        void setStartPosition();
+
+        /**
+         * @brief Charge une position au format FEN (Forsyth-Edwards).
+         *
+         * Les deux derniers champs (compteur des 50 coups, numéro du coup) sont facultatifs ;
+         * le numéro du coup est lu mais non conservé. Sont refusés : un nombre de rois différent de un
+         * par camp, des pions sur la 1ère ou la 8ème rangée, un droit de roque sans le roi et la tour
+         * sur leurs cases d'origine, une case de prise en passant sans pion adverse qui vient d'avancer
+         * de deux cases, un camp sans le trait laissé en échec. En cas d'erreur la position n'est pas modifiée.
+         *
+         * @param fen Chaîne FEN, ex: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1".
+         * @return true si la chaîne est valide, false sinon.
+         */
+        bool setFromFEN(const std::string& fen);
+
+        /**
+         * @brief Écrit la position au format FEN.
+         * @param fullmoveNumber Numéro du coup (non conservé par Position), 1 par défaut.
+         * @return Chaîne FEN complète (six champs).
+         */
+        std::string toFEN(int fullmoveNumber = 1) const;
+
+        /**
+         * @brief Obtient la pièce située à une case donnée.
+         * @param square Index de la case (0-63)
+         * @return Objet Piece représentant la pièce, ou une pièce "vide" si aucune.
+         */
+        Piece getPieceAtSquare(int square) const;
+
+        /// Code de la pièce présente sur une case (NoPiece si vide)
+        PieceCode getPieceCodeAt(int square) const { return mailbox[square]; }
+
+        /// Bitboard d'un type de pièce donné
+        uint64_t getPieceBitboard(PieceCode code) const { return bitboards[code]; }
+
+        /// Bitboard des cases occupées par une couleur
+        uint64_t getColorBitboard(PieceColor color) const { return colorBitboards[static_cast<int>(color)]; }
+
+        /// Indique si c'est le tour des blancs
+        bool getWhiteTurn() const { return whiteTurn; }
+
+        /**
+         * @brief Vérifie si la case spécifiée est vide.
+         * @param sq Index de la case (0-63)
+         */
+        bool isEmpty(int sq) const;
+
+        /**
+         * @brief Vérifie si la pièce à la case donnée est ennemie par rapport à la couleur spécifiée.
+         * @param sq Index de la case (0-63)
+         * @param whitePiece true si la pièce de référence est blanche, false si noire
+         */
+        bool isEnemy(int sq, bool whitePiece) const;
+
+        /**
+         * @brief Retourne toutes les pièces (des deux couleurs) qui attaquent une case.
+         *
+         * Chaque type de pièce est testé "à l'envers" depuis la case visée : une table ou une
+         * attaque magic par type, intersectée avec les bitboards correspondants.
+         *
+         * @param sq Case visée (0-63).
+         * @param occupancy Occupation à utiliser pour les pièces glissantes (permet d'ignorer une pièce).
+         * @return Bitboard des attaquants.
+         */
+        uint64_t attackersTo(int sq, uint64_t occupancy) const;
+
+        /**
+         * @brief Indique si une case est attaquée par une couleur.
+         *
+         * Les attaques sont projetées depuis la case visée (une lecture de table par type de pièce),
+         * avec sortie dès le premier attaquant trouvé : aucune génération de coups adverse.
+         *
+         * @param sq Case visée (0-63).
+         * @param byWhite true pour les attaques blanches, false pour les noires.
+         */
+        bool isSquareAttacked(int sq, bool byWhite) const;
+
+        /**
+         * @brief Indique si le roi de la couleur spécifiée est en échec.
+         * @param whiteKing true pour roi blanc, false pour roi noir.
+         */
+        bool isKingInCheck(bool whiteKing) const;
+
+        /**
+         * @brief Vérifie si un coup hypothétique laisserait le roi en échec.
+         * @param from Case d'origine (0-63).
+         * @param to Case de destination (0-63).
+         * @param whiteKing Couleur du roi à protéger (true = blanc).
+         */
+        bool wouldBeInCheck(int from, int to, bool whiteKing) const;
+
+        /**
+         * @brief Génère tous les coups pseudo-légaux du camp au trait (le roi peut rester en échec).
+         *
+         * Les promotions produisent quatre coups distincts (dame, tour, fou, cavalier) ;
+         * le roque n'est proposé que si le roi n'est pas en échec et ne traverse pas de case attaquée.
+         *
+         * @param list Liste remplie (vidée au préalable).
+         */
+        void generatePseudoLegalMoves(MoveList& list) const;
+
+        /**
+         * @brief Génère tous les coups légaux du camp au trait.
+         *
+         * La légalité est décidée sans jouer les coups : pièces clouées (restreintes à la ligne du roi),
+         * masque d'évitement en cas d'échec simple, roi seul autorisé à bouger en cas d'échec double,
+         * et cases d'arrivée du roi testées contre les attaques adverses. Seule la prise en passant,
+         * qui retire deux pièces d'une même rangée, est vérifiée en jouant le coup.
+         *
+         * @param list Liste remplie (vidée au préalable).
+         */
+        void generateLegalMoves(MoveList& list) const;
+
+        /**
+         * @brief Génère les seuls coups légaux tactiques du camp au trait : captures (promotions comprises,
+         * prise en passant incluse) et promotions en dame sans capture. Utilisé par la recherche de quiescence.
+         *
+         * @param list Liste remplie (vidée au préalable).
+         */
+        void generateLegalCaptures(MoveList& list) const;
+
+        /// Génération pseudo-légale commune ; avec `tacticalOnly`, seulement les coups de generateLegalCaptures
+        void generatePseudoLegal(MoveList& list, bool tacticalOnly) const;
+
+        /// Retire d'une liste pseudo-légale les coups qui laissent le roi en échec
+        void keepLegalMoves(MoveList& list) const;
+
+        /**
+         * @brief Retourne la liste des cases d'arrivée légales pour la pièce située à la case donnée.
+         * Une promotion n'apparaît qu'une fois, quelle que soit la pièce choisie ensuite.
+         * @param from Case de la pièce (0-63).
+         * @return Vecteur des cases accessibles légalement.
+         */
+        std::vector<int> getLegalMoves(int from) const;
+
+        /**
+         * @brief Indique si le camp au trait n'a aucun coup légal (mat ou pat).
+         * @param whiteToMove Camp à examiner (doit être le camp au trait).
+         */
+        bool noLegalMovesAvailable(bool whiteToMove) const;
+
+        /**
+         * @brief Vérifie si le matériel restant ne permet plus à aucun camp de mater.
+         */
+        bool isInsufficientMaterial() const;
+
+        /**
+         * @brief Joue un coup sur place, sans validation.
+         *
+         * Met à jour bitboards, mailbox, trait, roque, prise en passant, compteur des 50 coups
+         * et hash Zobrist. Le coup doit être légal.
+         *
+         * @param from Case d'origine (0-63).
+         * @param to Case de destination (0-63).
+         * @param promotion Pièce de promotion si un pion atteint la dernière rangée (Dame si None).
+         * @param undo Reçoit les informations nécessaires à undoMove.
+         */
+        void doMove(int from, int to, PieceType promotion, UndoInfo& undo);
+
+        /**
+         * @brief Annule un coup joué par doMove, en restaurant exactement la position précédente.
+         * @param from Case d'origine du coup annulé.
+         * @param to Case de destination du coup annulé.
+         * @param undo Informations remplies par doMove.
+         */
+        void undoMove(int from, int to, const UndoInfo& undo);
+
+        /**
+         * @brief Encode un coup donné par ses cases, avec les drapeaux déduits de la position
+         * (capture, prise en passant, double poussée, roque, promotion).
+         * @param from Case d'origine (0-63).
+         * @param to Case de destination (0-63).
+         * @param promotion Pièce de promotion si un pion atteint la dernière rangée (Dame si None).
+         */
+        Move encodeMove(int from, int to, PieceType promotion = PieceType::None) const;
+
+        /// Joue un coup encodé (voir Move.hpp), promotion comprise
+        void doMove(Move move, UndoInfo& undo) { doMove(move.from(), move.to(), move.promotionType(), undo); }
+
+        /// Annule un coup encodé joué par doMove
+        void undoMove(Move move, const UndoInfo& undo) { undoMove(move.from(), move.to(), undo); }
+
+        /**
+         * @brief Recalcule entièrement le hash Zobrist de la position.
+         */
+        uint64_t calculateZobristHash() const;
+
+        /**
+         * @brief Recalcule entièrement le hash des pions (clés Zobrist des pions blancs et noirs).
+         */
+        uint64_t calculatePawnHash() const;
+
+        /**
+         * @brief Recalcule entièrement le matériel, les bonus pièce-case des deux camps et la phase.
+         */
+        void recalculateScores();
+
+        /// Pose une pièce sur une case vide (bitboards, occupation, mailbox, hash et scores)
+        void putPiece(int sq, PieceCode code);
+
+        /// Retire la pièce présente sur une case (bitboards, occupation, mailbox, hash et scores)
+        void removePiece(int sq);
+
+        /// Déplace la pièce de `from` vers la case vide `to`
+        void movePiece(int from, int to);
+    };
+
+    /**
+     * @brief Compte les occurrences antérieures d'une position dans une pile de hashs.
+     *
+     * Une position ne peut se répéter qu'après le dernier coup irréversible (capture ou coup de pion),
+     * et seulement avec le même trait : on ne remonte donc que `halfmoveClock` demi-coups, de deux en deux.
+     * Une répétition demande au moins quatre demi-coups, d'où le point de départ `current - 4`.
+     *
+     * @param history Pile des hashs, du plus ancien au plus récent.
+     * @param current Index de la position examinée dans la pile.
+     * @param halfmoveClock Compteur des 50 coups de cette position.
+     * @param limit Arrête le parcours dès que ce nombre d'occurrences est atteint.
+     * @return Nombre d'occurrences antérieures trouvées (au plus `limit`).
+     */
+    inline int countRepetitions(const uint64_t* history, int current, int halfmoveClock, int limit) {
+        int count = 0;
+        int oldest = current - halfmoveClock;
+        for (int i = current - 4; i >= 0 && i >= oldest; i -= 2) {
+            if (history[i] == history[current] && ++count >= limit) break;
+        }
+        return count;
+    }
+
+    static_assert(std::is_trivially_copyable_v<Position>, "Position doit rester copiable par simple memcpy");
+    /*
+     * Taille garantie : 224 octets (3,5 lignes de cache de 64 octets), et non une ou deux lignes.
+     * Les 15 bitboards (pièces, couleurs, occupation) occupent déjà 120 octets ; la mailbox (64 octets,
+     * "qui est sur la case X" en temps constant pour doMove et l'ordre des coups) et les clés et scores
+     * incrémentaux (hash, hash des pions, matériel, pièce-case, phase) y sont ajoutés délibérément, car
+     * la recherche joue et annule les coups sur place : une Position n'est copiée qu'une fois par
+     * recherche et à chaque point de contrôle de ChessLogic.
+     */
+    inline constexpr size_t POSITION_MAX_BYTES = 224;
+    static_assert(sizeof(Position) <= POSITION_MAX_BYTES, "Position doit tenir en 224 octets (voir ci-dessus)");
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <chrono>
+#include "Move.hpp"
+
+namespace Jr {
+
+    /**
+     * @file TimeManager.hpp
+     * @brief Répartition du temps de réflexion de l'IA à partir de la pendule.
+     */
+
+    /// Contraintes d'une recherche : pendule du camp au trait (0 = pas de pendule, seule la profondeur limite)
+    struct SearchLimits {
+        double timeLeft = 0.0;  ///< Temps restant au camp au trait, en secondes
+        double increment = 0.0; ///< Incrément par coup, en secondes
+        int pliesPlayed = 0;    ///< Demi-coups déjà joués dans la partie (par les deux camps)
+        double moveTime = 0.0;  ///< Temps fixe pour ce coup, en secondes (0 = d'après la pendule) : utilisé jusqu'au bout
+    };
+
+    /**
+     * @class TimeManager
+     * @brief Fixe une limite souple et une limite dure pour une recherche à approfondissement itératif.
+     *
+     * - Limite souple : temps visé pour ce coup ; on ne commence pas une itération qu'on n'aura
+     *   probablement pas le temps de finir. Elle est allongée quand le meilleur coup change d'une
+     *   itération à l'autre et raccourcie quand il reste stable.
+     * - Limite dure : la recherche est interrompue en cours d'itération, quoi qu'il arrive ; elle garde
+     *   toujours une réserve sur la pendule pour que l'IA ne perde jamais au temps.
+     */
+    class TimeManager {
+    public:
+        /// Démarre le chronomètre et calcule les limites pour le coup à jouer
+        void start(const SearchLimits& limits);
+
+        /// Vrai si une pendule limite la recherche
+        bool isTimed() const { return timed; }
+
+        /// Secondes écoulées depuis start()
+        double elapsed() const;
+
+        /// Vrai si la limite dure est dépassée (à interroger régulièrement pendant la recherche)
+        bool hardLimitReached() const { return timed && elapsed() >= hardLimit; }
+
+        /**
+         * @brief À appeler après chaque itération complète, avec le meilleur coup trouvé.
+         * @return true s'il faut s'arrêter plutôt que commencer l'itération suivante.
+         */
+        bool iterationCompleted(Move bestMove);
+
+        double getSoftLimit() const { return softLimit; }
+        double getHardLimit() const { return hardLimit; }
+
+    private:
+        /// Réserve gardée sur la pendule (latence de l'interface, application du coup)
+        static constexpr double CLOCK_RESERVE = 0.5;
+
+        /// Meilleur coup inchangé sur autant d'itérations de suite : la recherche peut s'arrêter tôt
+        static constexpr int STABLE_ITERATIONS_TO_STOP = 4;
+
+        std::chrono::steady_clock::time_point startTime;
+        bool timed = false;
+        bool fixedMoveTime = false;
+        double softLimit = 0.0;
+        double hardLimit = 0.0;
+
+        Move previousBest = Move::none();
+        int stableIterations = 0;
+        double stabilityFactor = 1.0;
+    };
+}
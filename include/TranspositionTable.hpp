@@ -0,0 +1,96 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "Move.hpp"
+
+namespace Jr {
+
+    /**
+     * @file TranspositionTable.hpp
+     * @brief Table de transposition de taille fixe, partageable sans verrou entre threads de recherche.
+     */
+
+    /// Nature du score mémorisé par rapport à la fenêtre alpha-bêta de la recherche qui l'a produit
+    enum class Bound : uint8_t {
+        None  = 0,
+        Upper = 1, ///< Score réel <= score mémorisé (aucun coup n'a dépassé alpha)
+        Lower = 2, ///< Score réel >= score mémorisé (coupure beta)
+        Exact = 3
+    };
+
+    /// Contenu décodé d'une entrée de la table
+    struct TTEntry {
+        Move move = Move::none(); ///< Meilleur coup trouvé (Move::none() si aucun)
+        int score = 0;
+        int depth = 0;
+        Bound bound = Bound::None;
+    };
+
+    /**
+     * @class TranspositionTable
+     * @brief Table de transposition en seaux alignés sur une ligne de cache (4 entrées de 16 octets).
+     *
+     * Chaque entrée stocke (clé XOR données, données) en deux mots atomiques : une lecture qui croise
+     * une écriture concurrente ne vérifie plus le XOR et est ignorée, sans verrou. Les données regroupent
+     * le coup (16 bits), le score (32 bits), la profondeur (8 bits), le type de borne (2 bits) et
+     * la génération (6 bits), qui vieillit les entrées des recherches précédentes.
+     *
+     * Remplacement : même position, sinon l'entrée de moindre valeur (profondeur moins pénalité d'âge).
+     */
+    class TranspositionTable {
+    public:
+        /// Alloue la table (nombre de seaux arrondi à la puissance de deux inférieure)
+        explicit TranspositionTable(size_t megabytes = 16);
+
+        /// Marque le début d'une nouvelle recherche (les entrées plus anciennes deviennent remplaçables en priorité)
+        void newSearch() { generation = (generation + 1) & GENERATION_MASK; }
+
+        /// Vide toute la table
+        void clear();
+
+        /**
+         * @brief Cherche une position dans la table.
+         * @param hash Hash Zobrist de la position.
+         * @param entry Reçoit l'entrée trouvée.
+         * @return true si la position est présente.
+         */
+        bool probe(uint64_t hash, TTEntry& entry) const;
+
+        /// Mémorise le résultat de la recherche d'une position
+        void store(uint64_t hash, Move move, int score, int depth, Bound bound);
+
+        /// Précharge dans le cache le seau d'une position qui sera bientôt consultée
+        void prefetch(uint64_t hash) const {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(&buckets[hash & mask]);
+#else
+            (void)hash;
+#endif
+        }
+
+        /// Nombre d'entrées (4 par seau)
+        size_t size() const { return (mask + 1) * BUCKET_ENTRIES; }
+
+    private:
+        static constexpr int BUCKET_ENTRIES = 4;
+        static constexpr uint8_t GENERATION_MASK = 0x3F;
+
+        struct Entry {
+            std::atomic<uint64_t> check{0}; ///< hash XOR data
+            std::atomic<uint64_t> data{0};
+        };
+
+        struct alignas(64) Bucket {
+            Entry entries[BUCKET_ENTRIES];
+        };
+        static_assert(sizeof(Bucket) == 64, "Un seau doit occuper exactement une ligne de cache");
+
+        static uint64_t pack(Move move, int score, int depth, Bound bound, uint8_t generation);
+
+        std::unique_ptr<Bucket[]> buckets;
+        uint64_t mask = 0;
+        uint8_t generation = 0;
+    };
+}
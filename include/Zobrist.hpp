@@ -0,0 +1,64 @@
+#pragma once
+#include <cstdint>
+#include "Piece.hpp"
+
+namespace Jr {
+
+    /**
+     * @file Zobrist.hpp
+     * @brief Clés de hachage Zobrist, calculées à la compilation à partir d'une graine fixe.
+     *
+     * Les clés sont identiques d'une exécution et d'un processus à l'autre : un hash calculé
+     * aujourd'hui reste valable pour un livre d'ouvertures, un cache ou une base stockés sur disque.
+     */
+
+    /**
+     * @struct ZobristKeys
+     * @brief Tables plates des clés Zobrist, indexées par case et code de pièce.
+     */
+    struct ZobristKeys {
+        uint64_t pieces[64][PIECE_CODE_COUNT]; ///< [case][code de pièce] -> clé
+        uint64_t sideToMove;                   ///< Clé du trait (présente quand les blancs jouent)
+        uint64_t castling[16];                 ///< Clé des droits de roque (4 bits, 16 combinaisons)
+        uint64_t enPassant[8];                 ///< Clé de la colonne de prise en passant
+    };
+
+    namespace detail {
+
+        /**
+         * @brief Générateur SplitMix64, évaluable à la compilation.
+         * Chaque appel avance l'état et retourne 64 bits bien mélangés.
+         */
+        constexpr uint64_t splitMix64(uint64_t& state) {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /// Remplit toutes les clés dans un ordre fixe à partir de la graine donnée
+        constexpr ZobristKeys makeZobristKeys(uint64_t seed) {
+            ZobristKeys keys{};
+            uint64_t state = seed;
+            for (int sq = 0; sq < 64; ++sq) {
+                for (int code = 0; code < PIECE_CODE_COUNT; ++code) {
+                    keys.pieces[sq][code] = splitMix64(state);
+                }
+            }
+            keys.sideToMove = splitMix64(state);
+            for (int i = 0; i < 16; ++i) {
+                keys.castling[i] = splitMix64(state);
+            }
+            for (int i = 0; i < 8; ++i) {
+                keys.enPassant[i] = splitMix64(state);
+            }
+            return keys;
+        }
+    }
+
+    /// Clés Zobrist du programme (graine fixe : ne pas la changer sans invalider les hashs stockés)
+    inline constexpr ZobristKeys ZOBRIST = detail::makeZobristKeys(0x4A72436865737321ULL);
+
+    static_assert(ZOBRIST.pieces[0][0] != ZOBRIST.pieces[0][1] && ZOBRIST.sideToMove != 0ULL,
+                  "Clés Zobrist incorrectes");
+}
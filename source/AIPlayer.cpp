@@ -1,143 +1,291 @@
 #include "../include/AIPlayer.hpp"
+#include "../include/Bitboard.hpp"
 #include <limits>
 #include <algorithm>
 
 namespace Jr {
 
-AIPlayer::AIPlayer(int depth) : maxDepth(depth) {}
+AIPlayer::AIPlayer(int depth, size_t hashMegabytes) : maxDepth(depth), transpositionTable(hashMegabytes) {}
+
+int AIPlayer::scoreToTT(int score, int ply) {
+    // Un mat trouvé à `ply` demi-coups de la racine est à (MATE_SCORE - score - ply) demi-coups de ce nœud
+    if (score > MATE_SCORE - 2 * MAX_PLY) return score + ply;
+    if (score < -(MATE_SCORE - 2 * MAX_PLY)) return score - ply;
+    return score;
+}
+
+int AIPlayer::scoreFromTT(int score, int ply) {
+    if (score > MATE_SCORE - 2 * MAX_PLY) return score - ply;
+    if (score < -(MATE_SCORE - 2 * MAX_PLY)) return score + ply;
+    return score;
+}
+
+AIMove AIPlayer::findBestMove(const Position& position, const std::vector<uint64_t>& history,
+                              const SearchLimits& limits) {
+    Position copy = position;
+    nodeCount = 0;
+    cutoffCount = firstMoveCutoffCount = 0;
+    completedDepth = 0;
+    iterations.clear();
+    killers.fill({Move::none(), Move::none()});
+    historyTable.age();
+    searchStopped = false;
+    timeManager.start(limits);
+    pawnTable.resetCounters();
+    transpositionTable.newSearch();
+    hashStack.reserve(history.size() + MAX_PLY + 1);
+    hashStack.assign(history.begin(), history.end());
+    if (hashStack.empty() || hashStack.back() != copy.zobristHash) {
+        hashStack.push_back(copy.zobristHash);
+    }
 
-AIMove AIPlayer::findBestMove(const ChessLogic& logic) {
-    ChessLogic copy = logic;
     bool maximizing = copy.getWhiteTurn(); // Si c'est aux blancs de jouer, maximiser
-    return minimax(copy, maxDepth, std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), maximizing);
+
+    // Approfondissement itératif : chaque itération profite de la table de transposition remplie par
+    // la précédente, et il y a toujours un coup prêt si la pendule impose de s'arrêter
+    AIMove best;
+    for (int depth = 1; depth <= std::min(maxDepth, MAX_PLY - 1); ++depth) {
+        AIMove result = minimax(copy, depth, 0, std::numeric_limits<int>::min(),
+                                std::numeric_limits<int>::max(), maximizing);
+        // Itération interrompue : son résultat est incomplet, on garde celui de la précédente
+        if (searchStopped) break;
+
+        best = result;
+        completedDepth = depth;
+        if (best.from == -1) break; // Mat ou pat : aucun coup à jouer
+
+        Move bestMove = copy.encodeMove(best.from, best.to, best.promotion);
+        iterations.push_back({depth, bestMove, best.score, nodeCount, timeManager.elapsed()});
+        if (timeManager.iterationCompleted(bestMove)) break;
+    }
+    return best;
 }
 
-AIMove AIPlayer::minimax(ChessLogic node, int depth, int alpha, int beta, bool maximizingPlayer) {
+AIMove AIPlayer::minimax(Position& node, int depth, int ply, int alpha, int beta, bool maximizingPlayer) {
     AIMove best;
-    
-    // Nœud terminal ou profondeur 0
-    if (depth == 0) {
-        best.score = evaluate(node);
+
+    // Profondeur 0 : on poursuit les captures avant d'évaluer
+    if (depth == 0 || ply >= MAX_PLY) {
+        best.score = quiescence(node, ply, 0, alpha, beta, maximizingPlayer);
         return best;
     }
 
-    // Générer tous les coups légaux
-    bool toMoveIsWhite = node.getWhiteTurn();
-    int bestScore = maximizingPlayer ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+    ++nodeCount;
+    if (checkTime()) return best;
 
-    for (int from = 0; from < 64; ++from) {
-        Piece p = node.getPieceAtSquare(from);
-        if (p.isEmpty()) continue;
-        if ((p.color == PieceColor::White) != toMoveIsWhite) continue;
+    // Position déjà cherchée au moins aussi profondément : le score mémorisé suffit peut-être.
+    // Jamais à la racine, où il faut un coup à jouer ; le coup mémorisé sert en tout cas à l'ordre des coups.
+    int alphaOrig = alpha, betaOrig = beta;
+    TTEntry entry;
+    Move hashMove = Move::none();
+    if (transpositionTable.probe(node.zobristHash, entry)) {
+        hashMove = entry.move;
+        int score = scoreFromTT(entry.score, ply);
+        if (ply > 0 && entry.depth >= depth &&
+            (entry.bound == Bound::Exact ||
+             (entry.bound == Bound::Lower && score >= beta) ||
+             (entry.bound == Bound::Upper && score <= alpha))) {
+            best.score = score;
+            return best;
+        }
+    }
 
-        auto moves = node.getLegalMoves(from);
-        for (int to : moves) {
-            ChessLogic child = node;
-            simulateMoveAndResolve(child, from, to);
+    // Générer tous les coups légaux, en une seule passe et sans allocation
+    MoveList moves;
+    node.generateLegalMoves(moves);
 
-            // Si promotion en attente, promouvoir en dame
-            if (child.isPromotionPending()) {
-                child.promotePawn(child.getPromotionSquare(), PieceType::Queen);
-            }
+    // Aucun coup légal : échec et mat (le plus proche possible) ou pat
+    if (moves.empty()) {
+        if (node.isKingInCheck(node.getWhiteTurn())) {
+            best.score = node.getWhiteTurn() ? -(MATE_SCORE - ply) : (MATE_SCORE - ply);
+        } else {
+            best.score = 0;
+        }
+        return best;
+    }
+
+    int bestScore = maximizingPlayer ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+    Move bestMove = Move::none();
 
-            // Évaluer récursivement
-            AIMove reply = minimax(child, depth - 1, alpha, beta, !maximizingPlayer);
-            int score = reply.score;
+    bool white = node.getWhiteTurn();
+    MovePicker picker(node, moves, hashMove, killers[ply], historyTable);
+    Move move;
+    int movesTried = 0;
+    while (picker.next(move)) {
+        ++movesTried;
+        // Jouer le coup sur place, évaluer récursivement puis l'annuler
+        node.doMove(move, undoStack[ply]);
+        transpositionTable.prefetch(node.zobristHash);
+        hashStack.push_back(node.zobristHash);
 
-            if (maximizingPlayer) {
-                if (score > bestScore) {
-                    bestScore = score;
-                    best.from = from;
-                    best.to = to;
-                    best.score = score;
-                }
-                alpha = std::max(alpha, bestScore);
-                if (beta <= alpha) break; // Coupure bêta
-            } else {
-                if (score < bestScore) {
-                    bestScore = score;
-                    best.from = from;
-                    best.to = to;
-                    best.score = score;
+        // Une répétition (ou la règle des 50 coups) dans l'arbre est une nulle : inutile d'aller plus loin.
+        int score;
+        if (node.fiftyMoveCounter >= 100 ||
+            countRepetitions(hashStack.data(), static_cast<int>(hashStack.size()) - 1, node.fiftyMoveCounter, 1) > 0) {
+            score = 0;
+        } else {
+            score = minimax(node, depth - 1, ply + 1, alpha, beta, !maximizingPlayer).score;
+        }
+
+        hashStack.pop_back();
+        node.undoMove(move, undoStack[ply]);
+        if (searchStopped) return best;
+
+        if (maximizingPlayer ? score > bestScore : score < bestScore) {
+            bestScore = score;
+            best.from = move.from();
+            best.to = move.to();
+            best.promotion = move.promotionType();
+            best.score = score;
+            bestMove = move;
+        }
+        if (maximizingPlayer) {
+            alpha = std::max(alpha, bestScore);
+        } else {
+            beta = std::min(beta, bestScore);
+        }
+        if (beta <= alpha) {
+            // Coupure alpha-bêta : un coup tranquille réfuteur est retenu pour les positions sœurs
+            ++cutoffCount;
+            if (movesTried == 1) ++firstMoveCutoffCount;
+            if (MovePicker::isQuiet(move)) {
+                if (killers[ply][0] != move) {
+                    killers[ply][1] = killers[ply][0];
+                    killers[ply][0] = move;
                 }
-                beta = std::min(beta, bestScore);
-                if (beta <= alpha) break; // Coupure alpha
+                historyTable.reward(white, move, depth);
             }
+            break;
         }
-        if (beta <= alpha) break;
     }
 
-    // Si aucun coup trouvé (mat/pat), évaluer la position
-    if (best.from == -1 && best.to == -1) {
-        best.score = evaluate(node);
-    }
+    // Scores blancs : au-dessus de la fenêtre d'origine c'est un minorant, en dessous un majorant
+    Bound bound = bestScore <= alphaOrig ? Bound::Upper : (bestScore >= betaOrig ? Bound::Lower : Bound::Exact);
+    transpositionTable.store(node.zobristHash, bestMove, scoreToTT(bestScore, ply), depth, bound);
+
     return best;
 }
 
-void AIPlayer::simulateMoveAndResolve(ChessLogic& logicCopy, int from, int to) {
-    logicCopy.makeMove(from, to);
-    if (logicCopy.isPromotionPending()) {
-        logicCopy.promotePawn(logicCopy.getPromotionSquare(), PieceType::Queen);
+bool AIPlayer::checkTime() {
+    // Limite dure de la pendule : on remonte sans rien mémoriser (la première itération va toujours au bout)
+    if (completedDepth > 0 && (nodeCount % TIME_CHECK_INTERVAL) == 0 && timeManager.hardLimitReached()) {
+        searchStopped = true;
     }
+    return searchStopped;
 }
 
-int AIPlayer::evaluate(const ChessLogic& logic) const {
-    // Évaluation simple : matériel + bonus mobilité
-    auto board = logic.getCurrentBoardState();
-    int material = 0;
-    
-    for (const auto& [sq, piece] : board) {
-        int val = pieceValue(piece.type);
-        material += (piece.color == PieceColor::White) ? val : -val;
-    }
+int AIPlayer::quiescence(Position& node, int ply, int qPly, int alpha, int beta, bool maximizingPlayer) {
+    ++nodeCount;
+    if (checkTime()) return 0;
+    if (ply >= MAX_PLY) return evaluate(node);
+
+    // En échec au premier ply de quiescence : pas de stand pat, toutes les parades sont cherchées
+    // (c'est le seul endroit où la quiescence reconnaît un mat). Plus loin, l'échec est ignoré.
+    bool inCheck = qPly == 0 && node.isKingInCheck(node.getWhiteTurn());
 
-    // Mobilité : nombre de coups légaux
-    int mobility = 0;
-    bool whiteToMove = logic.getWhiteTurn();
-    
-    for (int from = 0; from < 64; ++from) {
-        Piece p = logic.getPieceAtSquare(from);
-        if (p.isEmpty()) continue;
-        
-        auto list = logic.getLegalMoves(from);
-        int moveCount = static_cast<int>(list.size());
-        
-        if (p.color == PieceColor::White) {
-            mobility += whiteToMove ? moveCount : -moveCount;
+    MoveList moves;
+    int standPat = 0;
+    int bestScore = maximizingPlayer ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+    if (inCheck) {
+        node.generateLegalMoves(moves);
+        if (moves.empty()) {
+            return node.getWhiteTurn() ? -(MATE_SCORE - ply) : (MATE_SCORE - ply);
+        }
+    } else {
+        // Stand pat d'abord : le camp au trait n'est pas obligé de capturer, et la plupart des nœuds
+        // s'arrêtent là sans générer un seul coup
+        standPat = evaluate(node);
+        bestScore = standPat;
+        if (maximizingPlayer) {
+            if (standPat >= beta) return standPat;
+            alpha = std::max(alpha, standPat);
         } else {
-            mobility += whiteToMove ? -moveCount : moveCount;
+            if (standPat <= alpha) return standPat;
+            beta = std::min(beta, standPat);
         }
+        node.generateLegalCaptures(moves);
     }
 
-    // Bonus de position pour les pions centraux
-    int positional = 0;
-    for (const auto& [sq, piece] : board) {
-        if (piece.type == PieceType::Pawn) {
-            int file = sq % 8;
-            int rank = sq / 8;
-            // Bonus pour pions centraux
-            if (file >= 2 && file <= 5) {
-                int bonus = (piece.color == PieceColor::White) ? rank : (7 - rank);
-                positional += (piece.color == PieceColor::White) ? bonus : -bonus;
-            }
+    static constexpr KillerMoves NO_KILLERS = {Move::none(), Move::none()};
+    MovePicker picker(node, moves, Move::none(), NO_KILLERS, historyTable);
+    Move move;
+    while (picker.next(move)) {
+        if (!inCheck) {
+            // Élagage delta : même en gagnant la pièce prise (et la promotion), le score resterait hors fenêtre
+            PieceType victim = move.isEnPassant() ? PieceType::Pawn : pieceCodeType(node.getPieceCodeAt(move.to()));
+            int gain = (victim == PieceType::None ? 0 : PIECE_VALUES[static_cast<int>(victim)]) + DELTA_MARGIN;
+            if (move.isPromotion()) gain += PIECE_VALUES[static_cast<int>(move.promotionType())] - PIECE_VALUES[0];
+            if (maximizingPlayer ? standPat + gain <= alpha : standPat - gain >= beta) continue;
+        }
+
+        node.doMove(move, undoStack[ply]);
+        int score = quiescence(node, ply + 1, qPly + 1, alpha, beta, !maximizingPlayer);
+        node.undoMove(move, undoStack[ply]);
+        if (searchStopped) return 0;
+
+        if (maximizingPlayer) {
+            bestScore = std::max(bestScore, score);
+            alpha = std::max(alpha, bestScore);
+        } else {
+            bestScore = std::min(bestScore, score);
+            beta = std::min(beta, bestScore);
         }
+        if (beta <= alpha) break;
     }
+    return bestScore;
+}
+
+int AIPlayer::evaluate(const Position& position) {
+    // Partie statique (matériel + bonus pièce-case) : tenue à jour par Position à chaque coup, simple lecture ici
+    int material = position.material[0] - position.material[1];
+
+    // Bonus pièce-case mélangés selon la phase : tables de milieu de partie avec toutes les pièces,
+    // de fin de partie quand il n'en reste plus (une promotion peut dépasser MAX_PHASE)
+    int phase = std::min<int>(position.phase, MAX_PHASE);
+    int middlegame = position.pieceSquareMiddlegame[0] - position.pieceSquareMiddlegame[1];
+    int endgame = position.pieceSquareEndgame[0] - position.pieceSquareEndgame[1];
+
+    // Structure de pions : presque toujours lue dans la table de hachage des pions
+    PawnScore pawns = pawnTable.probe(position);
+    middlegame += pawns.middlegame;
+    endgame += pawns.endgame;
+    int positional = (middlegame * phase + endgame * (MAX_PHASE - phase)) / MAX_PHASE;
+
+    // Mobilité des deux camps, lue sur les tables d'attaques
+    int mobilityScore = mobility(position, PieceColor::White) - mobility(position, PieceColor::Black);
 
     // Score combiné avec pondérations
-    int score = material * 100 + mobility * 3 + positional * 2;
+    int score = material + positional + mobilityScore * 3;
     return score;
 }
 
-int AIPlayer::pieceValue(PieceType t) const {
-    switch (t) {
-        case PieceType::Pawn:   return 1;
-        case PieceType::Knight: return 3;
-        case PieceType::Bishop: return 3;
-        case PieceType::Rook:   return 5;
-        case PieceType::Queen:  return 9;
-        case PieceType::King:   return 0;
-        default: return 0;
+int AIPlayer::mobility(const Position& position, PieceColor color) const {
+    bool white = (color == PieceColor::White);
+    uint64_t occupancy = position.bitboardPieces;
+
+    uint64_t targets = ~position.getColorBitboard(color);
+    if constexpr (MOBILITY_EXCLUDES_PAWN_ATTACKS) {
+        targets &= ~pawnAttacksSet(position.getPieceBitboard(white ? BlackPawn : WhitePawn), !white);
+    }
+
+    int count = 0;
+    uint64_t knights = position.getPieceBitboard(makePieceCode(PieceType::Knight, color));
+    while (knights) {
+        count += popCount(KNIGHT_ATTACKS[popLsb(knights)] & targets);
+    }
+    uint64_t bishops = position.getPieceBitboard(makePieceCode(PieceType::Bishop, color));
+    while (bishops) {
+        count += popCount(bishopAttacks(popLsb(bishops), occupancy) & targets);
+    }
+    uint64_t rooks = position.getPieceBitboard(makePieceCode(PieceType::Rook, color));
+    while (rooks) {
+        count += popCount(rookAttacks(popLsb(rooks), occupancy) & targets);
+    }
+    uint64_t queens = position.getPieceBitboard(makePieceCode(PieceType::Queen, color));
+    while (queens) {
+        count += popCount(queenAttacks(popLsb(queens), occupancy) & targets);
     }
+    return count;
 }
 
 } // namespace Jr
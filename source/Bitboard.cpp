@@ -0,0 +1,130 @@
+#include "../include/Bitboard.hpp"
+#include <mutex>
+#include <vector>
+
+namespace Jr {
+
+    namespace detail {
+        std::array<Magic, 64> rookMagics;
+        std::array<Magic, 64> bishopMagics;
+    }
+
+    namespace {
+
+        /// Tables d'attaques partagées par toutes les cases (taille totale des sous-tables "fancy")
+        std::array<uint64_t, 0x19000> rookTable;
+        std::array<uint64_t, 0x1480> bishopTable;
+
+        constexpr int ROOK_DIRECTIONS[4][2] = {{1,0}, {-1,0}, {0,1}, {0,-1}};
+        constexpr int BISHOP_DIRECTIONS[4][2] = {{1,1}, {1,-1}, {-1,1}, {-1,-1}};
+
+        /**
+         * @brief Calcule les attaques d'une pièce glissante en parcourant chaque rayon.
+         * Lent, mais utilisé uniquement pour remplir les tables à l'initialisation.
+         */
+        uint64_t slidingAttacks(const int (&directions)[4][2], int sq, uint64_t occupancy) {
+            uint64_t attacks = 0ULL;
+            for (const auto& d : directions) {
+                int r = sq / 8 + d[0], c = sq % 8 + d[1];
+                while (r >= 0 && r < 8 && c >= 0 && c < 8) {
+                    uint64_t bit = squareBit(r * 8 + c);
+                    attacks |= bit;
+                    if (occupancy & bit) break;
+                    r += d[0]; c += d[1];
+                }
+            }
+            return attacks;
+        }
+
+        /**
+         * @brief Générateur pseudo-aléatoire xorshift64* à graine fixe.
+         * La graine fixe rend la recherche des nombres magiques reproductible d'une exécution à l'autre.
+         */
+        class MagicRng {
+        public:
+            explicit MagicRng(uint64_t seed) : state(seed) {}
+
+            uint64_t next() {
+                state ^= state >> 12;
+                state ^= state << 25;
+                state ^= state >> 27;
+                return state * 2685821657736338717ULL;
+            }
+
+            /// Nombre avec peu de bits à 1, bien meilleur candidat magique
+            uint64_t sparse() { return next() & next() & next(); }
+
+        private:
+            uint64_t state;
+        };
+
+        /**
+         * @brief Cherche les nombres magiques d'un type de pièce et remplit sa table d'attaques.
+         * @param directions Directions de glissade de la pièce.
+         * @param magics Paramètres à remplir pour chaque case.
+         * @param table Table d'attaques partagée par les 64 cases.
+         */
+        void initMagics(const int (&directions)[4][2], std::array<Magic, 64>& magics, uint64_t* table) {
+            // Graines par rangée choisies pour converger rapidement (quelques dizaines de millisecondes au total).
+            constexpr uint64_t seeds[8] = {728, 10316, 55013, 32803, 12281, 15100, 16645, 255};
+            std::vector<uint64_t> occupancies;
+            std::vector<uint64_t> references;
+            std::vector<int> epoch;
+            uint64_t* attacks = table;
+
+            for (int sq = 0; sq < 64; ++sq) {
+                Magic& m = magics[sq];
+                MagicRng rng(seeds[sq / 8]);
+
+                // Les cases du bord ne bloquent jamais un rayon : elles sont exclues du masque.
+                uint64_t edges = ((RANK_1 | RANK_8) & ~(sq / 8 == 0 ? RANK_1 : sq / 8 == 7 ? RANK_8 : 0ULL))
+                               | ((FILE_A | FILE_H) & ~(sq % 8 == 0 ? FILE_A : sq % 8 == 7 ? FILE_H : 0ULL));
+                m.mask = slidingAttacks(directions, sq, 0ULL) & ~edges;
+                m.shift = 64 - popCount(m.mask);
+                m.attacks = attacks;
+
+                // Énumère tous les sous-ensembles du masque (Carry-Rippler) avec leurs attaques de référence.
+                occupancies.clear();
+                references.clear();
+                uint64_t subset = 0ULL;
+                do {
+                    occupancies.push_back(subset);
+                    references.push_back(slidingAttacks(directions, sq, subset));
+                    subset = (subset - m.mask) & m.mask;
+                } while (subset);
+
+                std::size_t size = occupancies.size();
+                epoch.assign(size, 0);
+
+                // Essaie des candidats jusqu'à trouver un nombre sans collision destructive.
+                for (int attempt = 1; ; ++attempt) {
+                    do {
+                        m.magic = rng.sparse();
+                    } while (popCount((m.mask * m.magic) >> 56) < 6);
+
+                    bool ok = true;
+                    for (std::size_t i = 0; i < size && ok; ++i) {
+                        uint64_t idx = m.index(occupancies[i]);
+                        if (epoch[idx] < attempt) {
+                            epoch[idx] = attempt;
+                            attacks[idx] = references[i];
+                        } else if (attacks[idx] != references[i]) {
+                            ok = false;
+                        }
+                    }
+                    if (ok) break;
+                }
+
+                attacks += size;
+            }
+        }
+    }
+
+    void initBitboards() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            initMagics(ROOK_DIRECTIONS, detail::rookMagics, rookTable.data());
+            initMagics(BISHOP_DIRECTIONS, detail::bishopMagics, bishopTable.data());
+        });
+    }
+}
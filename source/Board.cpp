@@ -1,5 +1,6 @@
 #include "../include/Board.hpp"
 #include "../include/constants.hpp"
+#include "../include/Bitboard.hpp"
 #include <iostream>
 
 namespace Jr {
@@ -166,16 +167,15 @@ void Board::draw(sf::RenderWindow& window) {
 
     // Roi en échec
     for (bool white : {true, false}) {
-        if (!chessLogic.isKingInCheck(white)) continue;
-        std::string kingName = white ? "wK" : "bK";
-        for (auto const& [sq, piece] : chessLogic.getCurrentBoardState()) {
-            if (piece.getName() != kingName) continue;
-            int row = sq / 8, col = sq % 8;
-            sf::RectangleShape check(sf::Vector2f(BOX_SIZE, BOX_SIZE));
-            check.setPosition(MARGIN + col * BOX_SIZE, MARGIN + (7 - row) * BOX_SIZE);
-            check.setFillColor(sf::Color(255, 0, 0, 120));
-            window.draw(check);
-        }
+        uint64_t king = chessLogic.getPieceBitboard(white ? Jr::WhiteKing : Jr::BlackKing);
+        if (king == 0ULL) continue;
+        int sq = Jr::lsb(king);
+        if (!chessLogic.isSquareAttacked(sq, !white)) continue;
+        int row = sq / 8, col = sq % 8;
+        sf::RectangleShape check(sf::Vector2f(BOX_SIZE, BOX_SIZE));
+        check.setPosition(MARGIN + col * BOX_SIZE, MARGIN + (7 - row) * BOX_SIZE);
+        check.setFillColor(sf::Color(255, 0, 0, 120));
+        window.draw(check);
     }
 
     if (chessLogic.isPromotionPending()) {
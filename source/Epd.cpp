@@ -0,0 +1,56 @@
+#include "../include/Epd.hpp"
+#include <sstream>
+
+namespace Jr {
+
+    bool parseEpdLine(const std::string& line, EpdRecord& record) {
+        std::istringstream stream(line);
+        std::string placement, side, castling, enPassant;
+        if (!(stream >> placement >> side >> castling >> enPassant) || placement[0] == '#') {
+            return false;
+        }
+
+        record = EpdRecord{};
+        std::string halfmove = "0", fullmove = "1";
+
+        // Opérations : "opcode opérande opérande ...;" (les opérandes entre guillemets peuvent contenir des espaces)
+        std::string rest;
+        std::getline(stream, rest);
+        size_t pos = 0;
+        while (pos < rest.size()) {
+            size_t end = pos;
+            bool quoted = false;
+            while (end < rest.size() && (quoted || rest[end] != ';')) {
+                if (rest[end] == '"') quoted = !quoted;
+                ++end;
+            }
+
+            std::istringstream operation(rest.substr(pos, end - pos));
+            std::string opcode, operand;
+            operation >> opcode;
+            std::vector<std::string> operands;
+            while (operation >> operand) {
+                operands.push_back(operand);
+            }
+
+            if (opcode == "bm") {
+                record.bestMoves = operands;
+            } else if (opcode == "am") {
+                record.avoidMoves = operands;
+            } else if (opcode == "id") {
+                std::string text = rest.substr(pos, end - pos);
+                size_t open = text.find('"'), close = text.rfind('"');
+                record.id = (open != std::string::npos && close > open) ? text.substr(open + 1, close - open - 1)
+                                                                        : (operands.empty() ? "" : operands.front());
+            } else if (opcode == "hmvc" && !operands.empty()) {
+                halfmove = operands.front();
+            } else if (opcode == "fmvn" && !operands.empty()) {
+                fullmove = operands.front();
+            }
+            pos = end + 1;
+        }
+
+        record.fen = placement + ' ' + side + ' ' + castling + ' ' + enPassant + ' ' + halfmove + ' ' + fullmove;
+        return true;
+    }
+}
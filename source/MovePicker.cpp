@@ -0,0 +1,66 @@
+#include "../include/MovePicker.hpp"
+#include <algorithm>
+
+namespace Jr {
+
+    void HistoryTable::reward(bool white, Move move, int depth) {
+        int32_t& entry = table[white ? 0 : 1][move.from()][move.to()];
+        entry += depth * depth;
+        if (entry > MAX_SCORE) {
+            age();
+        }
+    }
+
+    void HistoryTable::age() {
+        for (auto& side : table) {
+            for (auto& from : side) {
+                for (int32_t& entry : from) {
+                    entry /= 2;
+                }
+            }
+        }
+    }
+
+    MovePicker::MovePicker(const Position& position, MoveList& moves, Move hashMove, const KillerMoves& killers,
+                           const HistoryTable& history)
+        : moves(moves) {
+        bool white = position.getWhiteTurn();
+        for (int i = 0; i < moves.size(); ++i) {
+            Move move = moves[i];
+            int score;
+            if (move == hashMove) {
+                score = HASH_MOVE_SCORE;
+            } else if (move.isCapture() || move.promotionType() == PieceType::Queen) {
+                // MVV-LVA : la victime (ou la dame promue) d'abord, puis l'attaquant le moins cher
+                PieceType victim = move.isEnPassant() ? PieceType::Pawn : pieceCodeType(position.getPieceCodeAt(move.to()));
+                int victimValue = victim == PieceType::None ? 0 : static_cast<int>(victim) + 1;
+                if (move.promotionType() == PieceType::Queen) victimValue += static_cast<int>(PieceType::Queen);
+                int attacker = static_cast<int>(pieceCodeType(position.getPieceCodeAt(move.from())));
+                score = CAPTURE_SCORE + victimValue * 8 - attacker;
+            } else if (move.isPromotion()) {
+                score = UNDERPROMOTION_SCORE;
+            } else if (move == killers[0]) {
+                score = FIRST_KILLER_SCORE;
+            } else if (move == killers[1]) {
+                score = SECOND_KILLER_SCORE;
+            } else {
+                score = history.get(white, move);
+            }
+            scores[i] = score;
+        }
+    }
+
+    bool MovePicker::next(Move& move) {
+        if (current >= moves.size()) return false;
+
+        // Sélection du meilleur coup restant, échangé en tête de la partie non encore rendue
+        int best = current;
+        for (int i = current + 1; i < moves.size(); ++i) {
+            if (scores[i] > scores[best]) best = i;
+        }
+        std::swap(moves[current], moves[best]);
+        std::swap(scores[current], scores[best]);
+        move = moves[current++];
+        return true;
+    }
+}
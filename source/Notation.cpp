@@ -0,0 +1,91 @@
+#include "../include/Notation.hpp"
+#include "../include/Bitboard.hpp"
+#include <algorithm>
+
+namespace Jr {
+
+    namespace {
+        constexpr char PIECE_LETTER[] = {'P', 'N', 'B', 'R', 'Q', 'K'};
+
+        /// SAN sans suffixe d'échec
+        std::string baseSAN(const Position& position, Move move, const MoveList& legalMoves) {
+            if (move.isCastle()) {
+                return move.flag() == KingCastle ? "O-O" : "O-O-O";
+            }
+
+            int from = move.from(), to = move.to();
+            PieceType type = pieceCodeType(position.mailbox[from]);
+            std::string san;
+
+            if (type == PieceType::Pawn) {
+                if (move.isCapture()) san += static_cast<char>('a' + from % 8);
+            } else {
+                san += PIECE_LETTER[static_cast<int>(type)];
+
+                // Désambiguïsation : autres pièces du même type pouvant aller sur la même case
+                bool ambiguous = false, sameFile = false, sameRank = false;
+                for (Move other : legalMoves) {
+                    if (other.to() != to || other.from() == from ||
+                        position.mailbox[other.from()] != position.mailbox[from]) {
+                        continue;
+                    }
+                    ambiguous = true;
+                    sameFile = sameFile || other.from() % 8 == from % 8;
+                    sameRank = sameRank || other.from() / 8 == from / 8;
+                }
+                if (ambiguous) {
+                    if (!sameFile) {
+                        san += static_cast<char>('a' + from % 8);
+                    } else if (!sameRank) {
+                        san += static_cast<char>('1' + from / 8);
+                    } else {
+                        san += static_cast<char>('a' + from % 8);
+                        san += static_cast<char>('1' + from / 8);
+                    }
+                }
+            }
+
+            if (move.isCapture()) san += 'x';
+            san += static_cast<char>('a' + to % 8);
+            san += static_cast<char>('1' + to / 8);
+            if (move.isPromotion()) {
+                san += '=';
+                san += PIECE_LETTER[static_cast<int>(move.promotionType())];
+            }
+            return san;
+        }
+    }
+
+    std::string moveToSAN(const Position& position, Move move) {
+        MoveList legalMoves;
+        position.generateLegalMoves(legalMoves);
+        std::string san = baseSAN(position, move, legalMoves);
+
+        // Suffixe : échec, ou mat si l'adversaire n'a plus de coup légal
+        Position after = position;
+        UndoInfo undo;
+        after.doMove(move, undo);
+        if (after.isKingInCheck(after.whiteTurn)) {
+            san += after.noLegalMovesAvailable(after.whiteTurn) ? '#' : '+';
+        }
+        return san;
+    }
+
+    Move moveFromSAN(const Position& position, const std::string& text) {
+        // Retirer les annotations et normaliser le roque écrit avec des zéros
+        std::string wanted = text;
+        wanted.erase(std::remove_if(wanted.begin(), wanted.end(),
+                                    [](char c) { return c == '+' || c == '#' || c == '!' || c == '?'; }),
+                     wanted.end());
+        std::replace(wanted.begin(), wanted.end(), '0', 'O');
+
+        MoveList legalMoves;
+        position.generateLegalMoves(legalMoves);
+        for (Move move : legalMoves) {
+            if (baseSAN(position, move, legalMoves) == wanted || move.toUci() == text) {
+                return move;
+            }
+        }
+        return Move::none();
+    }
+}
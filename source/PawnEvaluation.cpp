@@ -0,0 +1,87 @@
+#include "../include/PawnEvaluation.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace Jr {
+
+    namespace {
+        /// Bonus d'un pion passé selon sa rangée relative (0 = rangée de départ des pièces)
+        constexpr int16_t PASSED_MIDDLEGAME[8] = {0, 5, 10, 15, 25, 40, 60, 0};
+        constexpr int16_t PASSED_ENDGAME[8] = {0, 10, 20, 35, 60, 90, 130, 0};
+
+        constexpr int16_t DOUBLED_MIDDLEGAME = -10, DOUBLED_ENDGAME = -20;
+        constexpr int16_t ISOLATED_MIDDLEGAME = -10, ISOLATED_ENDGAME = -15;
+        constexpr int16_t BACKWARD_MIDDLEGAME = -8, BACKWARD_ENDGAME = -10;
+
+        /// Score de structure d'un camp, de son propre point de vue
+        PawnScore evaluateSide(const Position& position, bool white) {
+            uint64_t own = position.getPieceBitboard(white ? WhitePawn : BlackPawn);
+            uint64_t enemy = position.getPieceBitboard(white ? BlackPawn : WhitePawn);
+            uint64_t enemyAttacks = pawnAttacksSet(enemy, !white);
+            int middlegame = 0, endgame = 0;
+
+            // Pions doublés : chaque pion en plus du premier sur une colonne
+            for (int file = 0; file < 8; ++file) {
+                int count = popCount(own & (FILE_A << file));
+                if (count > 1) {
+                    middlegame += DOUBLED_MIDDLEGAME * (count - 1);
+                    endgame += DOUBLED_ENDGAME * (count - 1);
+                }
+            }
+
+            uint64_t pawns = own;
+            while (pawns) {
+                int sq = popLsb(pawns);
+                int file = sq % 8;
+                int relativeRank = white ? sq / 8 : 7 - sq / 8;
+
+                // Pion passé : aucun pion adverse devant lui, sur sa colonne ni les voisines
+                // (un pion doublé derrière un autre n'est pas compté comme passé)
+                bool frontmost = (own & PASSED_PAWN_MASKS[white ? 0 : 1][sq] & (FILE_A << file)) == 0;
+                if (frontmost && (enemy & PASSED_PAWN_MASKS[white ? 0 : 1][sq]) == 0) {
+                    middlegame += PASSED_MIDDLEGAME[relativeRank];
+                    endgame += PASSED_ENDGAME[relativeRank];
+                }
+
+                uint64_t neighbours = own & ADJACENT_FILES[file];
+                if (neighbours == 0) {
+                    // Pion isolé : aucun pion ami sur les colonnes voisines
+                    middlegame += ISOLATED_MIDDLEGAME;
+                    endgame += ISOLATED_ENDGAME;
+                } else {
+                    // Pion arriéré : tous ses voisins sont plus avancés et sa case d'avance est tenue par un pion adverse
+                    uint64_t behindOrLevel = white ? (~0ULL >> (56 - 8 * (sq / 8))) : (~0ULL << (8 * (sq / 8)));
+                    int stop = white ? sq + 8 : sq - 8;
+                    if ((neighbours & behindOrLevel) == 0 && (enemyAttacks & squareBit(stop))) {
+                        middlegame += BACKWARD_MIDDLEGAME;
+                        endgame += BACKWARD_ENDGAME;
+                    }
+                }
+            }
+            return {static_cast<int16_t>(middlegame), static_cast<int16_t>(endgame)};
+        }
+    }
+
+    PawnScore evaluatePawnStructure(const Position& position) {
+        PawnScore white = evaluateSide(position, true);
+        PawnScore black = evaluateSide(position, false);
+        return {static_cast<int16_t>(white.middlegame - black.middlegame),
+                static_cast<int16_t>(white.endgame - black.endgame)};
+    }
+
+    PawnHashTable::PawnHashTable(size_t entryCount)
+        : entries(std::bit_floor(std::max<size_t>(entryCount, 1))), mask(entries.size() - 1) {}
+
+    PawnScore PawnHashTable::probe(const Position& position) {
+        ++probes;
+        Entry& entry = entries[position.pawnHash & mask];
+        if (entry.valid && entry.key == position.pawnHash) {
+            ++hits;
+            return entry.score;
+        }
+        entry.key = position.pawnHash;
+        entry.score = evaluatePawnStructure(position);
+        entry.valid = true;
+        return entry.score;
+    }
+}
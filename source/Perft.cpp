@@ -0,0 +1,87 @@
+#include "../include/Perft.hpp"
+#include <algorithm>
+#include <bit>
+#include <thread>
+
+namespace Jr {
+
+    PerftTable::PerftTable(size_t megabytes) {
+        size_t count = std::max<size_t>(1, megabytes * 1024 * 1024 / sizeof(Entry));
+        count = std::bit_floor(count);
+        entries = std::make_unique<Entry[]>(count);
+        mask = count - 1;
+    }
+
+    bool PerftTable::probe(uint64_t hash, int depth, uint64_t& nodes) const {
+        const Entry& entry = entries[hash & mask];
+        uint64_t data = entry.data.load(std::memory_order_relaxed);
+        uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ data) != hash || static_cast<int>(data & 0xFF) != depth) return false;
+        nodes = data >> 8;
+        return true;
+    }
+
+    void PerftTable::store(uint64_t hash, int depth, uint64_t nodes) {
+        Entry& entry = entries[hash & mask];
+        uint64_t data = (nodes << 8) | static_cast<uint64_t>(depth);
+        entry.check.store(hash ^ data, std::memory_order_relaxed);
+        entry.data.store(data, std::memory_order_relaxed);
+    }
+
+    uint64_t perft(Position& position, int depth, PerftTable* table) {
+        MoveList moves;
+        position.generateLegalMoves(moves);
+        if (depth <= 1) {
+            return depth == 1 ? static_cast<uint64_t>(moves.size()) : 1ULL;
+        }
+
+        uint64_t nodes = 0;
+        if (table && table->probe(position.zobristHash, depth, nodes)) {
+            return nodes;
+        }
+
+        for (Move move : moves) {
+            UndoInfo undo;
+            position.doMove(move, undo);
+            nodes += perft(position, depth - 1, table);
+            position.undoMove(move, undo);
+        }
+
+        if (table) {
+            table->store(position.zobristHash, depth, nodes);
+        }
+        return nodes;
+    }
+
+    std::vector<PerftDivideEntry> perftDivide(const Position& position, int depth, int threads, PerftTable* table) {
+        MoveList moves;
+        position.generateLegalMoves(moves);
+
+        std::vector<PerftDivideEntry> result(moves.size());
+        for (int i = 0; i < moves.size(); ++i) {
+            result[i] = {moves[i], 0ULL};
+        }
+
+        // Chaque thread prend le prochain coup racine libre : la charge s'équilibre d'elle-même
+        std::atomic<int> next{0};
+        auto worker = [&]() {
+            Position local = position;
+            for (int i = next++; i < moves.size(); i = next++) {
+                UndoInfo undo;
+                local.doMove(result[i].move, undo);
+                result[i].nodes = perft(local, depth - 1, table);
+                local.undoMove(result[i].move, undo);
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < std::max(1, threads); ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+        return result;
+    }
+}
@@ -4,6 +4,7 @@
 #include "../include/GameOverState.hpp"
 #include "../include/AIPlayer.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <random>
 
@@ -87,20 +88,48 @@ void PlayingState::onEnter() {
     }
     
     // Si mode AI vs AI ou (Humain vs IA et humain joue noirs), l'IA commence
-    if (gameMode == GameMode::AIvsAI || 
-        (gameMode == GameMode::HumanVsAI && playerSide == PlayerSide::Black)) {
+    if (isAITurn()) {
         // L'IA doit jouer en premier - de manière asynchrone
-        aiIsThinking = true;
-        std::cout << "IA réfléchit (profondeur " << aiPlayer.getDepth() << ")..." << std::endl;
-        ChessLogic logicCopy = chessLogic;
-        aiFuture = std::async(std::launch::async, [this, logicCopy]() {
-            return aiPlayer.findBestMove(logicCopy);
-        });
+        startAISearch();
     }
     
     std::cout << "Entering PlayingState." << std::endl;
 }
 
+bool PlayingState::isAITurn() const {
+    if (gameMode == GameMode::AIvsAI) {
+        // Les deux côtés sont joués par l'IA
+        return true;
+    }
+    if (gameMode == GameMode::HumanVsAI) {
+        // L'IA joue le camp opposé à celui de l'humain
+        return chessLogic.getWhiteTurn() == (playerSide == PlayerSide::Black);
+    }
+    return false;
+}
+
+void PlayingState::startAISearch() {
+    aiIsThinking = true;
+
+    // Position de départ de la recherche : le résultat n'est appliqué que si la partie y est toujours
+    aiRootSnapshot = chessLogic.getCurrentSnapshotIndex();
+    aiRootHash = chessLogic.getPosition().zobristHash;
+
+    // La pendule du camp au trait borne la réflexion : l'IA ne doit jamais perdre au temps
+    SearchLimits limits;
+    limits.timeLeft = chessLogic.getWhiteTurn() ? whiteTimeLeft : blackTimeLeft;
+    limits.pliesPlayed = chessLogic.getCurrentSnapshotIndex();
+    std::cout << "IA commence à réfléchir (profondeur " << aiPlayer.getDepth() << ", "
+              << limits.timeLeft << " s à la pendule)..." << std::endl;
+
+    // Lancer l'IA dans un thread séparé, sur des copies de la position et de l'historique
+    Position positionCopy = chessLogic.getPosition();
+    std::vector<uint64_t> historyCopy = chessLogic.getRepetitionHistory();
+    aiFuture = std::async(std::launch::async, [this, positionCopy, historyCopy, limits]() {
+        return aiPlayer.findBestMove(positionCopy, historyCopy, limits);
+    });
+}
+
 void PlayingState::handleInput(const sf::Event& event) {
     if (event.type == sf::Event::MouseButtonPressed &&
         event.mouseButton.button == sf::Mouse::Left) {
@@ -267,50 +296,40 @@ void PlayingState::update(float deltaTime) {
     if (!isViewingHistory && !aiIsThinking && currentMoveCount > lastMoveCount) {
         lastMoveCount = currentMoveCount;
         
-        // Déterminer si l'IA doit jouer
-        bool aiShouldPlay = false;
-        
-        if (gameMode == GameMode::HumanVsAI) {
-            // Humain contre IA
-            if (playerSide == PlayerSide::White) {
-                // Humain joue les blancs, IA joue les noirs
-                aiShouldPlay = !chessLogic.getWhiteTurn();
-            } else {
-                // Humain joue les noirs, IA joue les blancs
-                aiShouldPlay = chessLogic.getWhiteTurn();
-            }
-        } else if (gameMode == GameMode::AIvsAI) {
-            // Les deux côtés sont joués par l'IA
-            aiShouldPlay = true;
-        }
-        
-        if (aiShouldPlay) {
-            aiIsThinking = true;
-            std::cout << "IA commence à réfléchir (depth=" << aiPlayer.getDepth() << ")..." << std::endl;
-            
-            // Lancer l'IA dans un thread séparé
-            ChessLogic logicCopy = chessLogic;
-            aiFuture = std::async(std::launch::async, [this, logicCopy]() {
-                return aiPlayer.findBestMove(logicCopy);
-            });
+        if (isAITurn()) {
+            startAISearch();
         }
     }
     
-    // Vérifier si l'IA a terminé sa réflexion
-    if (aiIsThinking && aiFuture.valid()) {
+    // Vérifier si l'IA a terminé sa réflexion. Pendant la consultation de l'historique, le résultat
+    // attend le retour à la position courante.
+    if (aiIsThinking && aiFuture.valid() && !isViewingHistory) {
         if (aiFuture.wait_for(std::chrono::milliseconds(0)) == std::future_status::ready) {
             AIMove best = aiFuture.get();
+            aiIsThinking = false;
             std::cout << "IA a trouvé: " << best.from << " -> " << best.to << " (score=" << best.score << ")" << std::endl;
-            
-            if (best.from != -1) {
-                chessLogic.makeMove(best.from, best.to);
-                if (chessLogic.isPromotionPending()) {
-                    chessLogic.promotePawn(chessLogic.getPromotionSquare(), PieceType::Queen);
+
+            // La partie a pu changer pendant la réflexion (historique parcouru puis coup joué depuis
+            // une position passée) : le coup ne vaut que pour la position de départ de la recherche
+            const Position& position = chessLogic.getPosition();
+            if (chessLogic.getCurrentSnapshotIndex() != aiRootSnapshot || position.zobristHash != aiRootHash) {
+                std::cout << "Position modifiée pendant la réflexion : coup de l'IA ignoré." << std::endl;
+                lastMoveCount = static_cast<int>(chessLogic.getMoveHistory().size());
+                if (isAITurn()) {
+                    startAISearch();
+                }
+            } else if (best.from != -1) {
+                Move move = position.encodeMove(best.from, best.to, best.promotion);
+                MoveList legalMoves;
+                position.generateLegalMoves(legalMoves);
+                if (std::find(legalMoves.begin(), legalMoves.end(), move) != legalMoves.end()) {
+                    chessLogic.applyTrustedMove(move);
+                    board.updatePieceSprites();
+                } else {
+                    std::cerr << "Coup de l'IA illégal ignoré : " << move.toUci() << std::endl;
                 }
-                board.updatePieceSprites();
                 lastMoveCount = static_cast<int>(chessLogic.getMoveHistory().size());
             }
-            aiIsThinking = false;
         }
     }
 
@@ -0,0 +1,830 @@
+#include "../include/Position.hpp"
+#include "../include/Bitboard.hpp"
+#include <cstdlib>
+#include <sstream>
+#include <string_view>
+
+namespace Jr {
+
+    namespace {
+        /**
+         * @brief Droits de roque conservés lorsqu'un coup part de ou arrive sur chaque case.
+         * Un départ du roi ou d'une tour, ou une capture de tour sur sa case d'origine, retire le droit concerné.
+         */
+        constexpr std::array<uint8_t, 64> CASTLING_RIGHTS_MASK = [] {
+            std::array<uint8_t, 64> mask{};
+            mask.fill(CASTLE_ALL);
+            mask[0]  = CASTLE_ALL & ~CASTLE_WHITE_QUEENSIDE;                          // a1
+            mask[7]  = CASTLE_ALL & ~CASTLE_WHITE_KINGSIDE;                           // h1
+            mask[4]  = CASTLE_ALL & ~(CASTLE_WHITE_KINGSIDE | CASTLE_WHITE_QUEENSIDE); // e1
+            mask[56] = CASTLE_ALL & ~CASTLE_BLACK_QUEENSIDE;                          // a8
+            mask[63] = CASTLE_ALL & ~CASTLE_BLACK_KINGSIDE;                           // h8
+            mask[60] = CASTLE_ALL & ~(CASTLE_BLACK_KINGSIDE | CASTLE_BLACK_QUEENSIDE); // e8
+            return mask;
+        }();
+
+        /// Cases de départ et d'arrivée de la tour pour un roque dont le roi arrive sur `kingTo`
+        void castlingRookSquares(int kingTo, int& rookFrom, int& rookTo) {
+            int rank = kingTo / 8;
+            if (kingTo % 8 == 6) { // Roque côté roi (court) : tour de h à f.
+                rookFrom = rank * 8 + 7;
+                rookTo = rank * 8 + 5;
+            } else {               // Roque côté dame (long) : tour de a à d.
+                rookFrom = rank * 8 + 0;
+                rookTo = rank * 8 + 3;
+            }
+        }
+    }
+
+    /**
+     * @brief Définit la position de départ de toutes les pièces sur le plateau,
+     * et réinitialise le trait, les droits de roque, la prise en passant et le compteur des 50 coups.
+     */
+    void Position::setStartPosition() {
+        initBitboards(); // Tables magic des pièces glissantes (calculées une seule fois par processus)
+
+        // Initialisation des bitboards pour chaque type de pièce à leur position de départ standard.
+        // Chaque valeur hexadécimale représente un masque de 64 bits (uint64_t).
+        bitboards[WhitePawn]   = 0x000000000000FF00ULL; // Pions blancs sur la 2ème rangée (index 8-15)
+        bitboards[WhiteRook]   = 0x0000000000000081ULL; // Tours blanches sur a1 (0) et h1 (7)
+        bitboards[WhiteKnight] = 0x0000000000000042ULL; // Cavaliers blancs sur b1 (1) et g1 (6)
+        bitboards[WhiteBishop] = 0x0000000000000024ULL; // Fous blancs sur c1 (2) et f1 (5)
+        bitboards[WhiteQueen]  = 0x0000000000000008ULL; // Dame blanche sur d1 (3)
+        bitboards[WhiteKing]   = 0x0000000000000010ULL; // Roi blanc sur e1 (4)
+
+        bitboards[BlackPawn]   = 0x00FF000000000000ULL; // Pions noirs sur la 7ème rangée (index 48-55)
+        bitboards[BlackRook]   = 0x8100000000000000ULL; // Tours noires sur a8 (56) et h8 (63)
+        bitboards[BlackKnight] = 0x4200000000000000ULL; // Cavaliers noirs sur b8 (57) et g8 (62)
+        bitboards[BlackBishop] = 0x2400000000000000ULL; // Fous noirs sur c8 (58) et f8 (61)
+        bitboards[BlackQueen]  = 0x0800000000000000ULL; // Dame noire sur d8 (59)
+        bitboards[BlackKing]   = 0x1000000000000000ULL; // Roi noir sur e8 (60)
+
+        // Bitboards d'occupation (par couleur et global) et mailbox, dérivés des bitboards de pièces.
+        colorBitboards = {0ULL, 0ULL};
+        mailbox.fill(NoPiece);
+        for (int code = 0; code < PIECE_CODE_COUNT; ++code) {
+            uint64_t bb = bitboards[code];
+            colorBitboards[code / 6] |= bb;
+            while (bb) {
+                mailbox[popLsb(bb)] = static_cast<PieceCode>(code);
+            }
+        }
+        bitboardPieces = colorBitboards[0] | colorBitboards[1];
+
+        whiteTurn = true;              // Les blancs commencent.
+        enPassantSquare = -1;          // Aucune prise en passant possible au début.
+        castlingRights = CASTLE_ALL;   // Tous les roques sont disponibles.
+        fiftyMoveCounter = 0;
+        zobristHash = calculateZobristHash();
+        pawnHash = calculatePawnHash();
+        recalculateScores();
+    }
+
+    bool Position::setFromFEN(const std::string& fen) {
+        initBitboards();
+
+        std::istringstream fields(fen);
+        std::string placement, side, castling, enPassant;
+        if (!(fields >> placement >> side >> castling >> enPassant)) return false;
+        int halfmove = 0;
+        if (!(fields >> halfmove)) halfmove = 0; // Champs de compteurs facultatifs
+
+        Position result{};
+        result.mailbox.fill(NoPiece);
+
+        // 1) Placement des pièces, de la 8ème rangée vers la 1ère
+        static constexpr std::string_view PIECE_LETTERS = "PNBRQKpnbrqk"; // Même ordre que PieceCode
+        int rank = 7, file = 0;
+        for (char c : placement) {
+            if (c == '/') {
+                if (file != 8 || rank == 0) return false;
+                --rank;
+                file = 0;
+            } else if (c >= '1' && c <= '8') {
+                file += c - '0';
+                if (file > 8) return false;
+            } else {
+                size_t code = PIECE_LETTERS.find(c);
+                if (code == std::string_view::npos || file >= 8) return false;
+                result.putPiece(rank * 8 + file, static_cast<PieceCode>(code));
+                ++file;
+            }
+        }
+        if (rank != 0 || file != 8) return false;
+        if (popCount(result.bitboards[WhiteKing]) != 1 || popCount(result.bitboards[BlackKing]) != 1) return false;
+        // Aucun pion sur la 1ère ni sur la 8ème rangée
+        if ((result.bitboards[WhitePawn] | result.bitboards[BlackPawn]) & (RANK_1 | RANK_8)) return false;
+
+        // 2) Trait
+        if (side != "w" && side != "b") return false;
+        result.whiteTurn = (side == "w");
+
+        // 3) Droits de roque
+        result.castlingRights = 0;
+        if (castling != "-") {
+            for (char c : castling) {
+                switch (c) {
+                    case 'K': result.castlingRights |= CASTLE_WHITE_KINGSIDE; break;
+                    case 'Q': result.castlingRights |= CASTLE_WHITE_QUEENSIDE; break;
+                    case 'k': result.castlingRights |= CASTLE_BLACK_KINGSIDE; break;
+                    case 'q': result.castlingRights |= CASTLE_BLACK_QUEENSIDE; break;
+                    default: return false;
+                }
+            }
+        }
+        // Un droit de roque suppose le roi et la tour concernée sur leurs cases d'origine
+        struct CastlingHome { uint8_t right; int kingSquare; PieceCode king; int rookSquare; PieceCode rook; };
+        static constexpr CastlingHome CASTLING_HOMES[4] = {
+            {CASTLE_WHITE_KINGSIDE, 4, WhiteKing, 7, WhiteRook},
+            {CASTLE_WHITE_QUEENSIDE, 4, WhiteKing, 0, WhiteRook},
+            {CASTLE_BLACK_KINGSIDE, 60, BlackKing, 63, BlackRook},
+            {CASTLE_BLACK_QUEENSIDE, 60, BlackKing, 56, BlackRook},
+        };
+        for (const CastlingHome& home : CASTLING_HOMES) {
+            if ((result.castlingRights & home.right) &&
+                (result.mailbox[home.kingSquare] != home.king || result.mailbox[home.rookSquare] != home.rook)) {
+                return false;
+            }
+        }
+
+        // 4) Case de prise en passant
+        result.enPassantSquare = -1;
+        if (enPassant != "-") {
+            // Case sur la 6ème rangée si les blancs ont le trait (3ème sinon), vide, avec devant elle
+            // le pion adverse qui vient d'avancer de deux cases
+            if (enPassant.size() != 2 || enPassant[0] < 'a' || enPassant[0] > 'h' ||
+                enPassant[1] != (result.whiteTurn ? '6' : '3')) {
+                return false;
+            }
+            int square = (enPassant[1] - '1') * 8 + (enPassant[0] - 'a');
+            int pawnSquare = result.whiteTurn ? square - 8 : square + 8;
+            if (result.mailbox[square] != NoPiece || result.mailbox[pawnSquare] != (result.whiteTurn ? BlackPawn : WhitePawn)) {
+                return false;
+            }
+            result.enPassantSquare = static_cast<int8_t>(square);
+        }
+
+        // Le camp qui n'a pas le trait ne peut pas être en échec : son roi serait capturable
+        if (result.isKingInCheck(!result.whiteTurn)) return false;
+
+        // 5) Compteur des 50 coups
+        if (halfmove < 0) return false;
+        result.fiftyMoveCounter = static_cast<uint16_t>(halfmove);
+
+        result.zobristHash = result.calculateZobristHash();
+        *this = result;
+        return true;
+    }
+
+    std::string Position::toFEN(int fullmoveNumber) const {
+        static constexpr std::string_view PIECE_LETTERS = "PNBRQKpnbrqk";
+        std::string fen;
+
+        for (int rank = 7; rank >= 0; --rank) {
+            int empty = 0;
+            for (int file = 0; file < 8; ++file) {
+                PieceCode code = mailbox[rank * 8 + file];
+                if (code == NoPiece) {
+                    ++empty;
+                    continue;
+                }
+                if (empty > 0) fen += static_cast<char>('0' + empty);
+                empty = 0;
+                fen += PIECE_LETTERS[code];
+            }
+            if (empty > 0) fen += static_cast<char>('0' + empty);
+            if (rank > 0) fen += '/';
+        }
+
+        fen += whiteTurn ? " w " : " b ";
+
+        if (castlingRights == 0) fen += '-';
+        if (castlingRights & CASTLE_WHITE_KINGSIDE)  fen += 'K';
+        if (castlingRights & CASTLE_WHITE_QUEENSIDE) fen += 'Q';
+        if (castlingRights & CASTLE_BLACK_KINGSIDE)  fen += 'k';
+        if (castlingRights & CASTLE_BLACK_QUEENSIDE) fen += 'q';
+
+        if (enPassantSquare == -1) {
+            fen += " -";
+        } else {
+            fen += ' ';
+            fen += static_cast<char>('a' + enPassantSquare % 8);
+            fen += static_cast<char>('1' + enPassantSquare / 8);
+        }
+
+        fen += ' ' + std::to_string(fiftyMoveCounter) + ' ' + std::to_string(fullmoveNumber);
+        return fen;
+    }
+
+    /**
+     * @brief Récupère l'objet Piece (type et couleur) à une case donnée.
+     * Lit directement la mailbox, tenue à jour en parallèle des bitboards.
+     * @param square L'index de la case (0-63).
+     * @return L'objet Piece trouvé à la case. Si la case est vide ou invalide, retourne une Piece vide.
+     */
+    Piece Position::getPieceAtSquare(int square) const {
+        if (square < 0 || square >= 64) {
+            return Piece(); // Case invalide, retourne une pièce vide.
+        }
+        return Piece::fromCode(mailbox[square]);
+    }
+
+    /**
+     * @brief Vérifie si une case spécifique est vide.
+     * Utilise le bitboard `bitboardPieces` qui représente toutes les cases occupées.
+     */
+    bool Position::isEmpty(int sq) const {
+        return (bitboardPieces & (1ULL << sq)) == 0;
+    }
+
+    /**
+     * @brief Vérifie si une case contient une pièce ennemie par rapport à une pièce d'une couleur donnée.
+     */
+    bool Position::isEnemy(int sq, bool whitePiece) const {
+        // Une case vide n'appartient à aucune des deux couleurs : le test d'occupation adverse suffit.
+        return (colorBitboards[whitePiece ? 1 : 0] & (1ULL << sq)) != 0;
+    }
+
+    uint64_t Position::attackersTo(int sq, uint64_t occupancy) const {
+        uint64_t rooksQueens = bitboards[WhiteRook] | bitboards[BlackRook] | bitboards[WhiteQueen] | bitboards[BlackQueen];
+        uint64_t bishopsQueens = bitboards[WhiteBishop] | bitboards[BlackBishop] | bitboards[WhiteQueen] | bitboards[BlackQueen];
+        // Un pion blanc attaque `sq` s'il se trouve sur une case qu'un pion noir posé en `sq` attaquerait, et inversement.
+        return (PAWN_ATTACKS[1][sq] & bitboards[WhitePawn])
+             | (PAWN_ATTACKS[0][sq] & bitboards[BlackPawn])
+             | (KNIGHT_ATTACKS[sq] & (bitboards[WhiteKnight] | bitboards[BlackKnight]))
+             | (KING_ATTACKS[sq] & (bitboards[WhiteKing] | bitboards[BlackKing]))
+             | (rookAttacks(sq, occupancy) & rooksQueens)
+             | (bishopAttacks(sq, occupancy) & bishopsQueens);
+    }
+
+    bool Position::isSquareAttacked(int sq, bool byWhite) const {
+        int them = byWhite ? 0 : 6; // Décalage des codes de pièces de l'attaquant
+        // Du moins cher au plus cher : tables des pièces sauteuses, puis attaques magic des glissantes.
+        if (PAWN_ATTACKS[byWhite ? 1 : 0][sq] & bitboards[WhitePawn + them]) return true;
+        if (KNIGHT_ATTACKS[sq] & bitboards[WhiteKnight + them]) return true;
+        if (KING_ATTACKS[sq] & bitboards[WhiteKing + them]) return true;
+        uint64_t queens = bitboards[WhiteQueen + them];
+        if (bishopAttacks(sq, bitboardPieces) & (bitboards[WhiteBishop + them] | queens)) return true;
+        return (rookAttacks(sq, bitboardPieces) & (bitboards[WhiteRook + them] | queens)) != 0ULL;
+    }
+
+    /**
+     * @brief Vérifie si un roi est en échec.
+     * Détermine si la case du roi de la couleur spécifiée est attaquée par le camp adverse.
+     * @param whiteKing True pour vérifier le roi blanc, False pour le roi noir.
+     * @return True si le roi est en échec, False sinon.
+     */
+    bool Position::isKingInCheck(bool whiteKing) const {
+        uint64_t kingBB = bitboards[whiteKing ? WhiteKing : BlackKing];
+        if (kingBB == 0ULL) {
+            // Le roi n'est pas sur le plateau (cas anormal ou fin de partie).
+            return false;
+        }
+        return isSquareAttacked(lsb(kingBB), !whiteKing);
+    }
+
+    /**
+     * @brief Simule un coup pour vérifier si le roi serait en échec après ce coup.
+     * La position étant trivialement copiable, la simulation se fait sur une copie de taille fixe,
+     * avec le même doMove que la recherche : l'état original n'est pas modifié.
+     * @param from L'index de la case de départ de la pièce.
+     * @param to L'index de la case d'arrivée de la pièce.
+     * @param whiteKing La couleur du roi dont on vérifie l'échec (True si blanc, False si noir).
+     * @return True si le roi serait en échec après le coup simulé, False sinon.
+     */
+    bool Position::wouldBeInCheck(int from, int to, bool whiteKing) const {
+        if (mailbox[from] == NoPiece) {
+            return false;
+        }
+        Position simulated = *this;
+        UndoInfo undo;
+        simulated.doMove(from, to, PieceType::Queen, undo);
+        return simulated.isKingInCheck(whiteKing);
+    }
+
+    namespace {
+        /// Ajoute les quatre promotions d'un pion arrivant sur `to`, la dame en premier
+        void addPromotions(MoveList& list, int from, int to, bool capture) {
+            int base = capture ? KnightPromotionCapture : KnightPromotion;
+            for (int piece = 3; piece >= 0; --piece) {
+                list.add(Move(from, to, static_cast<MoveFlag>(base + piece)));
+            }
+        }
+
+        /// Ajoute un coup par case cible, avec le drapeau de capture si la case est occupée par l'adversaire
+        void addTargets(MoveList& list, int from, uint64_t targets, uint64_t enemy) {
+            while (targets) {
+                int to = popLsb(targets);
+                list.add(Move(from, to, (enemy & squareBit(to)) ? CaptureMove : QuietMove));
+            }
+        }
+    }
+
+    /**
+     * @brief Génère les coups pseudo-légaux du camp au trait directement à partir des bitboards.
+     * Les poussées de pion sont calculées pour tous les pions à la fois par décalage ;
+     * les autres pièces utilisent les tables d'attaques (sauteuses) et les tables magic (glissantes).
+     */
+    void Position::generatePseudoLegalMoves(MoveList& list) const {
+        generatePseudoLegal(list, false);
+    }
+
+    void Position::generatePseudoLegal(MoveList& list, bool tacticalOnly) const {
+        list.clear();
+        int us = whiteTurn ? 0 : 1;
+        PieceColor color = whiteTurn ? PieceColor::White : PieceColor::Black;
+        uint64_t own = colorBitboards[us];
+        uint64_t enemy = colorBitboards[1 - us];
+        uint64_t empty = ~bitboardPieces;
+        uint64_t promotionRank = whiteTurn ? RANK_8 : RANK_1;
+        int forward = whiteTurn ? 8 : -8;
+        // Coups tactiques seulement : les pièces ne vont que sur les cases adverses
+        uint64_t pieceTargets = tacticalOnly ? enemy : ~own;
+
+        // --- Pions ---
+        uint64_t pawns = bitboards[whiteTurn ? WhitePawn : BlackPawn];
+        uint64_t single = (whiteTurn ? shiftNorth(pawns) : shiftSouth(pawns)) & empty;
+        uint64_t doubles = (whiteTurn ? shiftNorth(single & RANK_3) : shiftSouth(single & RANK_6)) & empty;
+
+        uint64_t targets = tacticalOnly ? 0ULL : single & ~promotionRank;
+        while (targets) {
+            int to = popLsb(targets);
+            list.add(Move(to - forward, to));
+        }
+        targets = single & promotionRank;
+        while (targets) {
+            int to = popLsb(targets);
+            if (tacticalOnly) list.add(Move(to - forward, to, QueenPromotion));
+            else addPromotions(list, to - forward, to, false);
+        }
+        while (doubles && !tacticalOnly) {
+            int to = popLsb(doubles);
+            list.add(Move(to - 2 * forward, to, DoublePawnPush));
+        }
+
+        uint64_t capturingPawns = pawns;
+        while (capturingPawns) {
+            int from = popLsb(capturingPawns);
+            uint64_t captures = PAWN_ATTACKS[us][from] & enemy;
+            while (captures) {
+                int to = popLsb(captures);
+                if (squareBit(to) & promotionRank) addPromotions(list, from, to, true);
+                else list.add(Move(from, to, CaptureMove));
+            }
+            if (enPassantSquare != -1 && (PAWN_ATTACKS[us][from] & squareBit(enPassantSquare))) {
+                list.add(Move(from, enPassantSquare, EnPassantCapture));
+            }
+        }
+
+        // --- Cavaliers, fous, tours, dames et roi ---
+        uint64_t knights = bitboards[makePieceCode(PieceType::Knight, color)];
+        while (knights) {
+            int from = popLsb(knights);
+            addTargets(list, from, KNIGHT_ATTACKS[from] & pieceTargets, enemy);
+        }
+        uint64_t bishops = bitboards[makePieceCode(PieceType::Bishop, color)];
+        while (bishops) {
+            int from = popLsb(bishops);
+            addTargets(list, from, bishopAttacks(from, bitboardPieces) & pieceTargets, enemy);
+        }
+        uint64_t rooks = bitboards[makePieceCode(PieceType::Rook, color)];
+        while (rooks) {
+            int from = popLsb(rooks);
+            addTargets(list, from, rookAttacks(from, bitboardPieces) & pieceTargets, enemy);
+        }
+        uint64_t queens = bitboards[makePieceCode(PieceType::Queen, color)];
+        while (queens) {
+            int from = popLsb(queens);
+            addTargets(list, from, queenAttacks(from, bitboardPieces) & pieceTargets, enemy);
+        }
+        uint64_t king = bitboards[makePieceCode(PieceType::King, color)];
+        if (king == 0ULL) {
+            return;
+        }
+        int kingSquare = lsb(king);
+        addTargets(list, kingSquare, KING_ATTACKS[kingSquare] & pieceTargets, enemy);
+        if (tacticalOnly) {
+            return;
+        }
+
+        // --- Roque ---
+        // Les droits garantissent que le roi et la tour n'ont pas bougé ; il reste à vérifier que le chemin
+        // est libre, que le roi n'est pas en échec et qu'il ne traverse pas de case attaquée.
+        // La case d'arrivée est vérifiée comme pour tout autre coup par generateLegalMoves.
+        int backRank = whiteTurn ? 0 : 7;
+        bool kingside = castlingRights & (whiteTurn ? CASTLE_WHITE_KINGSIDE : CASTLE_BLACK_KINGSIDE);
+        bool queenside = castlingRights & (whiteTurn ? CASTLE_WHITE_QUEENSIDE : CASTLE_BLACK_QUEENSIDE);
+        if ((kingside || queenside) && !isSquareAttacked(kingSquare, !whiteTurn)) {
+            if (kingside && isEmpty(backRank * 8 + 5) && isEmpty(backRank * 8 + 6) &&
+                !isSquareAttacked(backRank * 8 + 5, !whiteTurn)) {
+                list.add(Move(kingSquare, backRank * 8 + 6, KingCastle));
+            }
+            if (queenside && isEmpty(backRank * 8 + 1) && isEmpty(backRank * 8 + 2) && isEmpty(backRank * 8 + 3) &&
+                !isSquareAttacked(backRank * 8 + 3, !whiteTurn)) {
+                list.add(Move(kingSquare, backRank * 8 + 2, QueenCastle));
+            }
+        }
+    }
+
+    /**
+     * @brief Génère les coups légaux en filtrant les coups pseudo-légaux (voir keepLegalMoves).
+     */
+    void Position::generateLegalMoves(MoveList& list) const {
+        generatePseudoLegal(list, false);
+        keepLegalMoves(list);
+    }
+
+    void Position::generateLegalCaptures(MoveList& list) const {
+        generatePseudoLegal(list, true);
+        keepLegalMoves(list);
+    }
+
+    /**
+     * @brief Filtre des coups pseudo-légaux à l'aide de masques calculés une seule fois par position
+     * (attaquants du roi, pièces clouées). La liste est compactée sur place.
+     */
+    void Position::keepLegalMoves(MoveList& list) const {
+        int us = whiteTurn ? 0 : 1;
+        uint64_t king = bitboards[whiteTurn ? WhiteKing : BlackKing];
+        if (king == 0ULL) {
+            return; // Position sans roi : rien à protéger.
+        }
+        int kingSquare = lsb(king);
+        uint64_t own = colorBitboards[us];
+        uint64_t enemy = colorBitboards[1 - us];
+
+        // Pièces adverses qui donnent échec, et masque des cases où une pièce peut parer un échec simple
+        // (capturer l'attaquant ou s'interposer).
+        uint64_t checkers = attackersTo(kingSquare, bitboardPieces) & enemy;
+        uint64_t evasionMask = ~0ULL;
+        if (checkers) {
+            evasionMask = checkers | BETWEEN[kingSquare][lsb(checkers)];
+        }
+        bool doubleCheck = popCount(checkers) > 1;
+
+        // Pièces clouées : une seule pièce alliée entre le roi et une pièce glissante adverse alignée.
+        PieceCode enemyQueen = whiteTurn ? BlackQueen : WhiteQueen;
+        uint64_t snipers = (rookAttacks(kingSquare, 0ULL) & (bitboards[whiteTurn ? BlackRook : WhiteRook] | bitboards[enemyQueen]))
+                         | (bishopAttacks(kingSquare, 0ULL) & (bitboards[whiteTurn ? BlackBishop : WhiteBishop] | bitboards[enemyQueen]));
+        uint64_t pinned = 0ULL;
+        while (snipers) {
+            uint64_t blockers = BETWEEN[kingSquare][popLsb(snipers)] & bitboardPieces;
+            if (popCount(blockers) == 1) pinned |= blockers & own;
+        }
+
+        // Le roi ne fait pas écran à l'attaque d'une pièce glissante sur les cases où il recule.
+        uint64_t occupancyWithoutKing = bitboardPieces & ~king;
+
+        int legal = 0;
+        for (int i = 0; i < list.size(); ++i) {
+            Move move = list[i];
+            int from = move.from();
+            int to = move.to();
+            bool isLegal;
+
+            if (from == kingSquare) {
+                // Roi : la case d'arrivée ne doit pas être attaquée (le roque a déjà vérifié son chemin).
+                isLegal = (attackersTo(to, occupancyWithoutKing) & enemy) == 0ULL;
+            } else if (doubleCheck) {
+                isLegal = false; // Seul le roi peut parer un échec double.
+            } else if (move.isEnPassant()) {
+                // La prise en passant retire deux pièces : cas rare vérifié en jouant le coup.
+                Position simulated = *this;
+                UndoInfo undo;
+                simulated.doMove(move, undo);
+                isLegal = !simulated.isKingInCheck(whiteTurn);
+            } else {
+                isLegal = (evasionMask & squareBit(to)) &&
+                          (!(pinned & squareBit(from)) || (LINE[kingSquare][from] & squareBit(to)));
+            }
+
+            if (isLegal) {
+                list[legal++] = move;
+            }
+        }
+        list.count = legal;
+    }
+
+    /**
+     * @brief Récupère tous les coups légaux pour une pièce à partir d'une case donnée.
+     * Filtre la liste produite par generateLegalMoves : l'interface et la recherche partagent ainsi
+     * exactement la même génération de coups, roque et prise en passant compris.
+     * @param from L'index de la case de départ de la pièce.
+     * @return Un vecteur d'entiers représentant les index des cases cibles légales.
+     */
+    std::vector<int> Position::getLegalMoves(int from) const {
+        std::vector<int> legalMoves;
+        if (mailbox[from] == NoPiece || (pieceCodeColor(mailbox[from]) == PieceColor::White) != whiteTurn) {
+            return legalMoves;
+        }
+
+        MoveList moves;
+        generateLegalMoves(moves);
+        for (Move move : moves) {
+            // Une seule entrée par promotion : la pièce est choisie ensuite par le joueur.
+            if (move.from() == from && (!move.isPromotion() || move.promotionType() == PieceType::Queen)) {
+                legalMoves.push_back(move.to());
+            }
+        }
+        return legalMoves;
+    }
+
+    bool Position::noLegalMovesAvailable(bool whiteToMove) const {
+        if (whiteToMove != whiteTurn) {
+            return true; // Le camp qui n'a pas le trait ne peut jouer aucun coup.
+        }
+        MoveList moves;
+        generateLegalMoves(moves);
+        return moves.empty();
+    }
+
+    bool Position::isInsufficientMaterial() const {
+        int whitePieces = 0;
+        int blackPieces = 0;
+        int whiteBishops = 0;
+        int blackBishops = 0;
+        int whiteKnights = 0;
+        int blackKnights = 0;
+        bool hasPawns = false;
+        bool hasRooksQueens = false;
+
+        // Couleur des cases des fous (true = case noire, false = case blanche)
+        std::vector<bool> whiteBishopSquares;
+        std::vector<bool> blackBishopSquares;
+
+        for (int code = 0; code < PIECE_CODE_COUNT; ++code) {
+            uint64_t bb = bitboards[code];
+            PieceType type = pieceCodeType(static_cast<PieceCode>(code));
+            bool white = pieceCodeColor(static_cast<PieceCode>(code)) == PieceColor::White;
+
+            // Pions, tours ou dames → matériel suffisant immédiatement
+            if (bb && type == PieceType::Pawn) hasPawns = true;
+            if (bb && (type == PieceType::Rook || type == PieceType::Queen)) hasRooksQueens = true;
+
+            while (bb) {
+                int sq = popLsb(bb);
+
+                if (white) {
+                    whitePieces++;
+                    if (type == PieceType::Bishop) {
+                        whiteBishops++;
+                        whiteBishopSquares.push_back(((sq / 8) + (sq % 8)) % 2);
+                    }
+                    if (type == PieceType::Knight) whiteKnights++;
+                } else {
+                    blackPieces++;
+                    if (type == PieceType::Bishop) {
+                        blackBishops++;
+                        blackBishopSquares.push_back(((sq / 8) + (sq % 8)) % 2);
+                    }
+                    if (type == PieceType::Knight) blackKnights++;
+                }
+            }
+        }
+
+        // 1) Matériel suffisant dès qu'il y a un pion, une tour ou une dame
+        if (hasPawns || hasRooksQueens) {
+            return false;
+        }
+
+        // 2) K vs K
+        if (whitePieces == 1 && blackPieces == 1) return true;
+
+        // 3) K+B vs K ou K+N vs K
+        if ((whitePieces == 2 && (whiteBishops == 1 || whiteKnights == 1) && blackPieces == 1) ||
+            (blackPieces == 2 && (blackBishops == 1 || blackKnights == 1) && whitePieces == 1)) {
+            return true;
+        }
+
+        // 4) K+N+N vs K → Draw (deux cavaliers ne peuvent pas mater seuls)
+        if ((whitePieces == 3 && whiteKnights == 2 && blackPieces == 1) ||
+            (blackPieces == 3 && blackKnights == 2 && whitePieces == 1)) {
+            return true;
+        }
+
+        // 5) K+B vs K+B (Draw uniquement si les deux fous sont sur la même couleur de case)
+        if (whitePieces == 2 && blackPieces == 2 && whiteBishops == 1 && blackBishops == 1) {
+            if (!whiteBishopSquares.empty() && !blackBishopSquares.empty() &&
+                whiteBishopSquares[0] == blackBishopSquares[0]) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void Position::putPiece(int sq, PieceCode code) {
+        uint64_t bit = squareBit(sq);
+        bitboards[code] |= bit;
+        colorBitboards[code / 6] |= bit;
+        bitboardPieces |= bit;
+        mailbox[sq] = code;
+        zobristHash ^= ZOBRIST.pieces[sq][code];
+        if (code % 6 == 0) pawnHash ^= ZOBRIST.pieces[sq][code];
+        material[code / 6] += PIECE_VALUES[code % 6];
+        pieceSquareMiddlegame[code / 6] += PIECE_SQUARE_MIDDLEGAME[code][sq];
+        pieceSquareEndgame[code / 6] += PIECE_SQUARE_ENDGAME[code][sq];
+        phase += PHASE_WEIGHTS[code % 6];
+    }
+
+    void Position::removePiece(int sq) {
+        PieceCode code = mailbox[sq];
+        uint64_t bit = squareBit(sq);
+        bitboards[code] &= ~bit;
+        colorBitboards[code / 6] &= ~bit;
+        bitboardPieces &= ~bit;
+        mailbox[sq] = NoPiece;
+        zobristHash ^= ZOBRIST.pieces[sq][code];
+        if (code % 6 == 0) pawnHash ^= ZOBRIST.pieces[sq][code];
+        material[code / 6] -= PIECE_VALUES[code % 6];
+        pieceSquareMiddlegame[code / 6] -= PIECE_SQUARE_MIDDLEGAME[code][sq];
+        pieceSquareEndgame[code / 6] -= PIECE_SQUARE_ENDGAME[code][sq];
+        phase -= PHASE_WEIGHTS[code % 6];
+    }
+
+    void Position::movePiece(int from, int to) {
+        PieceCode code = mailbox[from];
+        uint64_t fromTo = squareBit(from) | squareBit(to);
+        bitboards[code] ^= fromTo;
+        colorBitboards[code / 6] ^= fromTo;
+        bitboardPieces ^= fromTo;
+        mailbox[to] = code;
+        mailbox[from] = NoPiece;
+        zobristHash ^= ZOBRIST.pieces[from][code] ^ ZOBRIST.pieces[to][code];
+        if (code % 6 == 0) pawnHash ^= ZOBRIST.pieces[from][code] ^ ZOBRIST.pieces[to][code];
+        pieceSquareMiddlegame[code / 6] += PIECE_SQUARE_MIDDLEGAME[code][to] - PIECE_SQUARE_MIDDLEGAME[code][from];
+        pieceSquareEndgame[code / 6] += PIECE_SQUARE_ENDGAME[code][to] - PIECE_SQUARE_ENDGAME[code][from];
+    }
+
+    /**
+     * @brief Joue un coup sur place en ne mettant à jour que l'état du plateau.
+     * Le hash Zobrist est mis à jour incrémentalement (XOR des clés qui changent).
+     */
+    void Position::doMove(int from, int to, PieceType promotion, UndoInfo& undo) {
+        const ZobristKeys& keys = ZOBRIST;
+        PieceCode moving = mailbox[from];
+        PieceType type = pieceCodeType(moving);
+        bool white = (moving < BlackPawn);
+
+        // Sauvegarde de ce qui ne peut pas être déduit du coup.
+        undo.movedPiece = moving;
+        undo.capturedPiece = mailbox[to];
+        undo.castlingRights = castlingRights;
+        undo.enPassantSquare = enPassantSquare;
+        undo.fiftyMoveCounter = fiftyMoveCounter;
+        undo.zobristHash = zobristHash;
+
+        // Les anciens droits de roque et l'ancienne colonne en passant sortent du hash.
+        zobristHash ^= keys.castling[castlingRights];
+        if (enPassantSquare != -1) zobristHash ^= keys.enPassant[enPassantSquare % 8];
+
+        // --- Gérer la capture (normale ou en passant) ---
+        if (undo.capturedPiece != NoPiece) {
+            removePiece(to);
+        } else if (type == PieceType::Pawn && to == enPassantSquare) {
+            int capturedPawnSquare = white ? to - 8 : to + 8;
+            undo.capturedPiece = mailbox[capturedPawnSquare];
+            removePiece(capturedPawnSquare);
+        }
+
+        // --- Déplacer la pièce ---
+        movePiece(from, to);
+
+        if (type == PieceType::Pawn) {
+            // Promotion : le pion est remplacé par la pièce choisie (Dame par défaut).
+            if (to / 8 == 7 || to / 8 == 0) {
+                removePiece(to);
+                putPiece(to, makePieceCode(promotion == PieceType::None ? PieceType::Queen : promotion,
+                                           white ? PieceColor::White : PieceColor::Black));
+            }
+        } else if (type == PieceType::King && std::abs(from % 8 - to % 8) == 2) {
+            // --- Gestion du roque (déplacement de la tour associé) ---
+            int rookFrom, rookTo;
+            castlingRookSquares(to, rookFrom, rookTo);
+            movePiece(rookFrom, rookTo);
+        }
+
+        // --- Mettre à jour les droits de roque ---
+        castlingRights &= CASTLING_RIGHTS_MASK[from] & CASTLING_RIGHTS_MASK[to];
+
+        // --- Mettre à jour la case de prise en passant pour le prochain tour ---
+        // Si un pion a avancé de deux cases, la case derrière lui devient une case de prise en passant potentielle.
+        enPassantSquare = -1;
+        if (type == PieceType::Pawn && std::abs(to - from) == 16) {
+            enPassantSquare = static_cast<int8_t>((from + to) / 2);
+        }
+
+        // Compteur des 50 coups : remis à zéro par une capture ou un coup de pion.
+        if (type == PieceType::Pawn || undo.capturedPiece != NoPiece) fiftyMoveCounter = 0;
+        else ++fiftyMoveCounter;
+
+        // --- Changer le tour ---
+        whiteTurn = !whiteTurn;
+        zobristHash ^= keys.sideToMove;
+        zobristHash ^= keys.castling[castlingRights];
+        if (enPassantSquare != -1) zobristHash ^= keys.enPassant[enPassantSquare % 8];
+    }
+
+    Move Position::encodeMove(int from, int to, PieceType promotion) const {
+        PieceType type = pieceCodeType(mailbox[from]);
+        bool capture = mailbox[to] != NoPiece;
+
+        if (type == PieceType::Pawn) {
+            if (to / 8 == 7 || to / 8 == 0) {
+                if (promotion == PieceType::None) promotion = PieceType::Queen;
+                int piece = static_cast<int>(promotion) - static_cast<int>(PieceType::Knight);
+                return Move(from, to, static_cast<MoveFlag>((capture ? KnightPromotionCapture : KnightPromotion) + piece));
+            }
+            if (to == enPassantSquare) return Move(from, to, EnPassantCapture);
+            if (std::abs(to - from) == 16) return Move(from, to, DoublePawnPush);
+        } else if (type == PieceType::King && std::abs(from % 8 - to % 8) == 2) {
+            return Move(from, to, to % 8 == 6 ? KingCastle : QueenCastle);
+        }
+        return Move(from, to, capture ? CaptureMove : QuietMove);
+    }
+
+    void Position::undoMove(int from, int to, const UndoInfo& undo) {
+        whiteTurn = !whiteTurn;
+
+        // Remet la pièce d'origine (un pion si le coup était une promotion) sur sa case de départ.
+        removePiece(to);
+        putPiece(from, undo.movedPiece);
+
+        PieceType type = pieceCodeType(undo.movedPiece);
+        if (type == PieceType::King && std::abs(from % 8 - to % 8) == 2) {
+            int rookFrom, rookTo;
+            castlingRookSquares(to, rookFrom, rookTo);
+            movePiece(rookTo, rookFrom);
+        }
+
+        // Replace la pièce capturée, derrière la case d'arrivée en cas de prise en passant.
+        if (undo.capturedPiece != NoPiece) {
+            int capturedSquare = to;
+            if (type == PieceType::Pawn && to == undo.enPassantSquare) {
+                capturedSquare = (undo.movedPiece == WhitePawn) ? to - 8 : to + 8;
+            }
+            putPiece(capturedSquare, undo.capturedPiece);
+        }
+
+        castlingRights = undo.castlingRights;
+        enPassantSquare = undo.enPassantSquare;
+        fiftyMoveCounter = undo.fiftyMoveCounter;
+        zobristHash = undo.zobristHash;
+    }
+
+    void Position::recalculateScores() {
+        material = {0, 0};
+        pieceSquareMiddlegame = {0, 0};
+        pieceSquareEndgame = {0, 0};
+        phase = 0;
+        for (int code = 0; code < PIECE_CODE_COUNT; ++code) {
+            uint64_t bb = bitboards[code];
+            while (bb) {
+                int sq = popLsb(bb);
+                material[code / 6] += PIECE_VALUES[code % 6];
+                pieceSquareMiddlegame[code / 6] += PIECE_SQUARE_MIDDLEGAME[code][sq];
+                pieceSquareEndgame[code / 6] += PIECE_SQUARE_ENDGAME[code][sq];
+                phase += PHASE_WEIGHTS[code % 6];
+            }
+        }
+    }
+
+    uint64_t Position::calculatePawnHash() const {
+        uint64_t hash = 0ULL;
+        for (PieceCode code : {WhitePawn, BlackPawn}) {
+            uint64_t bb = bitboards[code];
+            while (bb) {
+                hash ^= ZOBRIST.pieces[popLsb(bb)][code];
+            }
+        }
+        return hash;
+    }
+
+    uint64_t Position::calculateZobristHash() const {
+        const ZobristKeys& keys = ZOBRIST;
+        uint64_t hash = 0ULL;
+
+        // Hash des pièces
+        for (int code = 0; code < PIECE_CODE_COUNT; ++code) {
+            uint64_t bb = bitboards[code];
+            while (bb) {
+                hash ^= keys.pieces[popLsb(bb)][code];
+            }
+        }
+
+        // Hash du trait
+        if (whiteTurn) {
+            hash ^= keys.sideToMove;
+        }
+
+        // Hash des droits de roque (représentation binaire des 4 droits : K, Q, k, q)
+        hash ^= keys.castling[castlingRights];
+
+        // Hash de la case de prise en passant
+        if (enPassantSquare != -1) {
+            hash ^= keys.enPassant[enPassantSquare % 8]; // Seule la colonne compte pour Zobrist
+        }
+
+        return hash;
+    }
+}
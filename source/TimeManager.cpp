@@ -0,0 +1,62 @@
+#include "../include/TimeManager.hpp"
+#include <algorithm>
+
+namespace Jr {
+
+    void TimeManager::start(const SearchLimits& limits) {
+        startTime = std::chrono::steady_clock::now();
+        previousBest = Move::none();
+        stableIterations = 0;
+        stabilityFactor = 1.0;
+
+        // Temps fixe par coup : la seule limite est la limite dure, aucune itération n'est écourtée
+        fixedMoveTime = limits.moveTime > 0.0;
+        if (fixedMoveTime) {
+            timed = true;
+            softLimit = hardLimit = limits.moveTime;
+            return;
+        }
+
+        timed = limits.timeLeft > 0.0;
+        if (!timed) {
+            softLimit = hardLimit = 0.0;
+            return;
+        }
+
+        // Nombre de coups encore à jouer estimé d'après l'avancement de la partie (entre 20 et 40) :
+        // un de moins à chaque coup complet (deux demi-coups) déjà joué
+        int movesToGo = std::clamp(40 - limits.pliesPlayed / 2, 20, 40);
+        double available = std::max(0.0, limits.timeLeft - CLOCK_RESERVE);
+
+        softLimit = available / movesToGo + 0.75 * limits.increment;
+        // Jamais plus du quart du temps restant pour un seul coup, ni plus de trois fois le temps visé
+        hardLimit = std::min({softLimit * 3.0, available * 0.25 + limits.increment * 0.5, available});
+        softLimit = std::min(softLimit, hardLimit);
+    }
+
+    double TimeManager::elapsed() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    bool TimeManager::iterationCompleted(Move bestMove) {
+        // Stabilité du meilleur coup : un changement allonge la réflexion, la constance la raccourcit
+        if (bestMove == previousBest) {
+            ++stableIterations;
+            stabilityFactor = std::max(0.5, stabilityFactor * 0.85);
+        } else {
+            stableIterations = 0;
+            stabilityFactor = std::min(2.0, stabilityFactor * 1.5);
+        }
+        previousBest = bestMove;
+
+        if (!timed || fixedMoveTime) return false;
+
+        // L'itération suivante coûte en général plusieurs fois la précédente : ne pas la commencer
+        // si elle a peu de chances de finir dans le temps visé
+        double target = std::min(softLimit * stabilityFactor, hardLimit);
+        double spent = elapsed();
+        // Coup confirmé itération après itération : inutile de consommer tout le temps visé
+        if (stableIterations >= STABLE_ITERATIONS_TO_STOP && spent >= target * 0.25) return true;
+        return spent >= target * 0.6;
+    }
+}
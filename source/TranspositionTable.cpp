@@ -0,0 +1,88 @@
+#include "../include/TranspositionTable.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace Jr {
+
+    namespace {
+        // Disposition des données : coup (bits 0-15), score (16-47), profondeur (48-55), borne (56-57), génération (58-63)
+        constexpr Move unpackMove(uint64_t data) { return Move::fromRaw(static_cast<uint16_t>(data)); }
+        constexpr int unpackScore(uint64_t data) { return static_cast<int32_t>(static_cast<uint32_t>(data >> 16)); }
+        constexpr int unpackDepth(uint64_t data) { return static_cast<int>((data >> 48) & 0xFF); }
+        constexpr Bound unpackBound(uint64_t data) { return static_cast<Bound>((data >> 56) & 0x3); }
+        constexpr uint8_t unpackGeneration(uint64_t data) { return static_cast<uint8_t>(data >> 58); }
+    }
+
+    TranspositionTable::TranspositionTable(size_t megabytes) {
+        size_t count = std::max<size_t>(1, megabytes * 1024 * 1024 / sizeof(Bucket));
+        count = std::bit_floor(count);
+        buckets = std::make_unique<Bucket[]>(count);
+        mask = count - 1;
+    }
+
+    void TranspositionTable::clear() {
+        for (uint64_t i = 0; i <= mask; ++i) {
+            for (Entry& entry : buckets[i].entries) {
+                entry.check.store(0, std::memory_order_relaxed);
+                entry.data.store(0, std::memory_order_relaxed);
+            }
+        }
+        generation = 0;
+    }
+
+    uint64_t TranspositionTable::pack(Move move, int score, int depth, Bound bound, uint8_t generation) {
+        return static_cast<uint64_t>(move.raw())
+             | (static_cast<uint64_t>(static_cast<uint32_t>(score)) << 16)
+             | (static_cast<uint64_t>(std::clamp(depth, 0, 255)) << 48)
+             | (static_cast<uint64_t>(bound) << 56)
+             | (static_cast<uint64_t>(generation) << 58);
+    }
+
+    bool TranspositionTable::probe(uint64_t hash, TTEntry& entry) const {
+        const Bucket& bucket = buckets[hash & mask];
+        for (const Entry& slot : bucket.entries) {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            uint64_t check = slot.check.load(std::memory_order_relaxed);
+            if ((check ^ data) == hash && unpackBound(data) != Bound::None) {
+                entry.move = unpackMove(data);
+                entry.score = unpackScore(data);
+                entry.depth = unpackDepth(data);
+                entry.bound = unpackBound(data);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void TranspositionTable::store(uint64_t hash, Move move, int score, int depth, Bound bound) {
+        Bucket& bucket = buckets[hash & mask];
+
+        // Choix de l'entrée : la même position si elle est présente, sinon celle de moindre valeur
+        Entry* victim = nullptr;
+        int victimValue = 0;
+        for (Entry& slot : bucket.entries) {
+            uint64_t data = slot.data.load(std::memory_order_relaxed);
+            uint64_t check = slot.check.load(std::memory_order_relaxed);
+            if ((check ^ data) == hash) {
+                // Même position : ne pas écraser une analyse plus profonde de la recherche en cours par une borne
+                if (bound != Bound::Exact && unpackGeneration(data) == generation && unpackDepth(data) > depth + 2) {
+                    return;
+                }
+                // Conserver le meilleur coup connu si la nouvelle recherche n'en a pas trouvé
+                if (move == Move::none()) move = unpackMove(data);
+                victim = &slot;
+                break;
+            }
+            int age = (generation - unpackGeneration(data)) & GENERATION_MASK;
+            int value = unpackDepth(data) - 4 * age;
+            if (victim == nullptr || value < victimValue) {
+                victim = &slot;
+                victimValue = value;
+            }
+        }
+
+        uint64_t data = pack(move, score, depth, bound, generation);
+        victim->check.store(hash ^ data, std::memory_order_relaxed);
+        victim->data.store(data, std::memory_order_relaxed);
+    }
+}
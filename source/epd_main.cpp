@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "../include/AIPlayer.hpp"
+#include "../include/Epd.hpp"
+#include "../include/Notation.hpp"
+
+/**
+ * @file epd_main.cpp
+ * @brief Outil en ligne de commande `chess-epd` : passe une suite de tests EPD à l'IA.
+ *
+ * Chaque position est cherchée une fois, par approfondissement itératif jusqu'à la profondeur
+ * maximale ou jusqu'à épuisement du temps imparti. Une position est résolue si le coup trouvé figure
+ * dans "bm" et ne figure pas dans "am" ; le temps de solution est celui de l'itération à partir de
+ * laquelle la réponse est restée correcte.
+ */
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage : chess-epd <fichier.epd> [--depth N] [--time MS]\n"
+                  << "  --depth  Profondeur maximale en demi-coups (défaut : 4)\n"
+                  << "  --time   Temps par position en millisecondes (0 = sans limite, défaut)\n";
+    }
+
+    /// Indique si `move` figure dans une liste de coups SAN de l'EPD
+    bool contains(const std::vector<std::string>& sanList, const Jr::Position& position, Jr::Move move) {
+        return std::any_of(sanList.begin(), sanList.end(),
+                           [&](const std::string& text) { return Jr::moveFromSAN(position, text) == move; });
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    std::string path = argv[1];
+    int maxDepth = 0;
+    int timeLimitMs = 0;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--depth" && i + 1 < argc) {
+            maxDepth = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--time" && i + 1 < argc) {
+            timeLimitMs = std::max(0, std::atoi(argv[++i]));
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Sans profondeur explicite : 4, ou illimitée si c'est le temps imparti qui borne la recherche
+    if (maxDepth == 0) {
+        maxDepth = timeLimitMs > 0 ? 64 : 4;
+    }
+
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Erreur: impossible d'ouvrir " << path << std::endl;
+        return 1;
+    }
+
+    Jr::AIPlayer ai;
+    ai.setDepth(maxDepth);
+    int total = 0, solved = 0;
+    uint64_t totalNodes = 0;
+    uint64_t pawnProbes = 0, pawnHits = 0;
+    double cutoffRateSum = 0.0;
+    double totalSeconds = 0.0;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        Jr::EpdRecord record;
+        if (!Jr::parseEpdLine(line, record)) continue;
+
+        Jr::Position position;
+        if (!position.setFromFEN(record.fen)) {
+            std::cerr << "FEN invalide ignorée : " << record.fen << std::endl;
+            continue;
+        }
+        ++total;
+
+        // Une seule recherche par position, bornée par le temps imparti ; le temps de solution est lu
+        // sur les itérations complètes : depuis quand la réponse est-elle restée correcte ?
+        Jr::SearchLimits limits;
+        limits.moveTime = timeLimitMs / 1000.0;
+        auto start = std::chrono::steady_clock::now();
+        ai.findBestMove(position, {}, limits);
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        uint64_t nodes = ai.getNodeCount();
+        double cutoffRate = ai.getFirstMoveCutoffRate();
+        pawnProbes += ai.getPawnTable().getProbes();
+        pawnHits += ai.getPawnTable().getHits();
+
+        double solvedAt = -1.0;
+        Jr::Move found = Jr::Move::none();
+        for (const Jr::SearchIteration& iteration : ai.getIterations()) {
+            found = iteration.move;
+            bool correct = (record.bestMoves.empty() || contains(record.bestMoves, position, found)) &&
+                           !contains(record.avoidMoves, position, found);
+            if (!correct) {
+                solvedAt = -1.0;
+            } else if (solvedAt < 0.0) {
+                solvedAt = iteration.seconds;
+            }
+        }
+
+        bool ok = solvedAt >= 0.0;
+        solved += ok ? 1 : 0;
+        totalNodes += nodes;
+        totalSeconds += elapsed;
+        cutoffRateSum += cutoffRate;
+
+        std::cout << (ok ? "OK    " : "ECHEC ") << std::left << std::setw(12)
+                  << (record.id.empty() ? std::to_string(total) : record.id)
+                  << " coup " << std::setw(8) << (found == Jr::Move::none() ? "-" : Jr::moveToSAN(position, found));
+        if (ok) {
+            std::cout << " solution en " << std::fixed << std::setprecision(3) << solvedAt << " s";
+        }
+        std::cout << "  " << nodes << " nœuds, "
+                  << static_cast<uint64_t>(elapsed > 0.0 ? nodes / elapsed : 0.0) << " nœuds/s, "
+                  << std::fixed << std::setprecision(1) << 100.0 * cutoffRate << " % de coupures au 1er coup"
+                  << std::endl;
+    }
+
+    std::cout << "Résolues : " << solved << " / " << total << "  (" << totalNodes << " nœuds en "
+              << std::fixed << std::setprecision(3) << totalSeconds << " s, "
+              << static_cast<uint64_t>(totalSeconds > 0.0 ? totalNodes / totalSeconds : 0.0) << " nœuds/s)"
+              << std::endl;
+    std::cout << "Table des pions : " << std::setprecision(1)
+              << (pawnProbes > 0 ? 100.0 * pawnHits / pawnProbes : 0.0) << " % de réussite sur " << pawnProbes
+              << " accès" << std::endl;
+    std::cout << "Coupures au premier coup : "
+              << (total > 0 ? 100.0 * cutoffRateSum / total : 0.0) << " % en moyenne" << std::endl;
+    return 0;
+}
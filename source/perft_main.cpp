@@ -0,0 +1,126 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include "../include/Perft.hpp"
+
+/**
+ * @file perft_main.cpp
+ * @brief Outil en ligne de commande `chess-perft` : vérification et mesure de la génération de coups.
+ *
+ * Sans --fen, joue toutes les positions de référence et vérifie leurs comptes (code de retour 1 en cas d'écart).
+ * Avec --fen, compte les nœuds de la position donnée ; --divide affiche le détail par coup racine.
+ */
+
+namespace {
+
+    void printUsage() {
+        std::cout << "Usage : chess-perft [--fen \"<FEN>\"] [--depth N] [--divide] [--hash MB] [--threads N]\n"
+                  << "  --fen      Position à analyser (sinon : positions de référence)\n"
+                  << "  --depth    Profondeur en demi-coups (défaut : 5, ou celle de chaque référence)\n"
+                  << "  --divide   Affiche le nombre de nœuds par coup racine\n"
+                  << "  --hash     Taille de la table de hachage en Mo (0 = sans table, défaut)\n"
+                  << "  --threads  Nombre de threads (défaut : nombre de cœurs)\n";
+    }
+
+    struct PerftRun {
+        uint64_t nodes = 0;
+        double seconds = 0.0;
+    };
+
+    /// Lance un perft réparti entre les threads, en affichant le détail par coup si demandé
+    PerftRun runPerft(const Jr::Position& position, int depth, int threads, Jr::PerftTable* table, bool divide) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Jr::PerftDivideEntry> entries = Jr::perftDivide(position, depth, threads, table);
+        PerftRun run;
+        run.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (const Jr::PerftDivideEntry& entry : entries) {
+            if (divide) {
+                std::cout << entry.move.toUci() << ": " << entry.nodes << "\n";
+            }
+            run.nodes += entry.nodes;
+        }
+        return run;
+    }
+
+    uint64_t nodesPerSecond(const PerftRun& run) {
+        return run.seconds > 0.0 ? static_cast<uint64_t>(run.nodes / run.seconds) : 0ULL;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string fen;
+    int depth = 0;
+    bool divide = false;
+    size_t hashMegabytes = 0;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--fen" && hasValue) {
+            fen = argv[++i];
+        } else if (arg == "--depth" && hasValue) {
+            depth = std::atoi(argv[++i]);
+        } else if (arg == "--divide") {
+            divide = true;
+        } else if (arg == "--hash" && hasValue) {
+            hashMegabytes = static_cast<size_t>(std::atoll(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else {
+            printUsage();
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::unique_ptr<Jr::PerftTable> table;
+    if (hashMegabytes > 0) {
+        table = std::make_unique<Jr::PerftTable>(hashMegabytes);
+    }
+
+    // Une position donnée : perft simple ou détaillé
+    if (!fen.empty()) {
+        Jr::Position position;
+        if (!position.setFromFEN(fen)) {
+            std::cerr << "Erreur: FEN invalide : " << fen << std::endl;
+            return 1;
+        }
+        PerftRun run = runPerft(position, depth > 0 ? depth : 5, threads, table.get(), divide);
+        std::cout << "\nNœuds : " << run.nodes << "\nTemps : " << run.seconds << " s\nNœuds/s : "
+                  << nodesPerSecond(run) << std::endl;
+        return 0;
+    }
+
+    // Positions de référence : vérification des comptes et débit global
+    bool allPassed = true;
+    PerftRun total;
+    for (const Jr::PerftReferencePosition& reference : Jr::PERFT_REFERENCE_POSITIONS) {
+        Jr::Position position;
+        position.setFromFEN(reference.fen);
+        int referenceDepth = depth > 0 ? std::min(depth, reference.depth) : reference.depth;
+        if (divide) {
+            std::cout << "--- " << reference.name << " ---\n";
+        }
+        PerftRun run = runPerft(position, referenceDepth, threads, table.get(), divide);
+        total.nodes += run.nodes;
+        total.seconds += run.seconds;
+
+        // Le compte de référence n'est connu qu'à la profondeur indiquée
+        bool checked = referenceDepth == reference.depth;
+        bool passed = !checked || run.nodes == reference.nodes;
+        allPassed = allPassed && passed;
+        std::cout << (passed ? (checked ? "OK    " : "--    ") : "ECHEC ") << reference.name << " (profondeur "
+                  << referenceDepth << ") : " << run.nodes;
+        if (!passed) {
+            std::cout << " au lieu de " << reference.nodes;
+        }
+        std::cout << "  " << run.seconds << " s, " << nodesPerSecond(run) << " nœuds/s" << std::endl;
+    }
+    std::cout << "Total : " << total.nodes << " nœuds en " << total.seconds << " s ("
+              << nodesPerSecond(total) << " nœuds/s)" << std::endl;
+    return allPassed ? 0 : 1;
+}